@@ -0,0 +1,254 @@
+/*********************************************************************************************************
+Benchmark driver of make bench
+Every benchmark of the corpus is run a number of warm-up times and repetitions, each consisting of
+	load:		parsing the instance, including the generation of meetings
+	compile:	parsing the solution, and building the packed schedule
+	validate:	checking all constraints and calculating the objective
+The median and 95th percentile of every phase are reported on stdout, and written as JSON to the results file.
+With -compare, the medians are compared with those of an earlier results file: a phase that became slower than
+the tolerance, or a changed objective, is reported as a regression, and the driver exits with status 1.
+*********************************************************************************************************/
+
+// Include std
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Include other
+#include "ClassInterface.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const char* phaseNames[] = { "load", "compile", "validate" };
+static const int nrPhases = 3;
+
+// Differences of the median below this number of milliseconds are not reported as a regression: timer noise
+static const double minRegression = 0.05;
+
+struct Benchmark {
+	std::string name;
+	std::string instance;
+	std::string solution;
+	std::vector<double> times[nrPhases]; 	// Milliseconds per repetition
+	ObjCost objective = std::make_pair(-1, -1);
+	bool failed = false;
+};
+
+// Results of a benchmark in an earlier results file
+struct BaselineEntry {
+	ObjCost objective = std::make_pair(-1, -1);
+	double medians[nrPhases] = {0, 0, 0};
+	bool failed = false;
+};
+
+static double elapsed(const Clock::time_point start){
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Nearest-rank percentile of the repetitions
+static double percentile(std::vector<double> times, const double p){
+	if (times.empty()) { return 0; }
+	std::sort(times.begin(), times.end());
+	int rank = (int) (p/100*times.size() + 0.999999) - 1;
+	return times[std::max(0, std::min(rank, (int) times.size() - 1))];
+}
+
+// Read the corpus: one benchmark per line with its name, instance, and solution; # starts a comment
+static std::vector<Benchmark> readCorpus(const std::string file){
+	std::vector<Benchmark> corpus;
+	std::ifstream in(file);
+	if (!in) {
+		std::cerr << "Cannot read benchmark corpus " << file << "." << std::endl;
+		return corpus;
+	}
+	std::string line;
+	while (std::getline(in, line)) {
+		if (line.empty() || line[0] == '#') { continue; }
+		std::istringstream fields(line);
+		Benchmark b;
+		if (!(fields >> b.name >> b.instance >> b.solution)) { continue; }
+
+		// The parser does not report missing files: skip them here
+		if (!std::ifstream(b.instance) || !std::ifstream(b.solution)) {
+			std::cerr << "Cannot read " << b.instance << " or " << b.solution << "." << std::endl;
+			b.failed = true;
+		}
+		corpus.push_back(b);
+	}
+	return corpus;
+}
+
+// Run all phases once, and add their times if record is set
+static void run(Benchmark& b, const bool record){
+	double times[nrPhases];
+	try {
+		Clock::time_point start = Clock::now();
+		Interface::reset();
+		Instance::reset();
+		Interface::get()->readInstanceXml(b.instance);
+		times[0] = elapsed(start);
+
+		start = Clock::now();
+		Interface::get()->readSolutionXml(b.solution);
+		Instance::get()->getPackedSchedule();
+		times[1] = elapsed(start);
+
+		start = Clock::now();
+		b.objective = Interface::get()->checkConstr(true);
+		times[2] = elapsed(start);
+	} catch(InterfaceReadingException e) {
+		std::cerr << e.what() << std::endl;
+		b.failed = true;
+		return;
+	}
+	if (record) {
+		for (int p = 0; p < nrPhases; ++p) { b.times[p].push_back(times[p]); }
+	}
+}
+
+static void printJson(std::ostream& out, const std::vector<Benchmark>& corpus, const int warmup, const int repetitions){
+	out << std::setprecision(6) << "{\n  \"warmup\": " << warmup << ",\n  \"repetitions\": " << repetitions << ",\n  \"benchmarks\": [";
+	for (size_t i = 0; i < corpus.size(); ++i) {
+		const Benchmark& b = corpus[i];
+		out << (i ? ",\n" : "\n") << "    {\"name\": \"" << b.name << "\", \"instance\": \"" << b.instance << "\", \"solution\": \"" << b.solution << "\", ";
+		if (b.failed) {
+			out << "\"failed\": true}";
+			continue;
+		}
+		out << "\"objective\": [" << b.objective.first << ", " << b.objective.second << "], \"phases\": {";
+		for (int p = 0; p < nrPhases; ++p) {
+			out << (p ? ", " : "") << "\"" << phaseNames[p] << "\": {\"median\": " << percentile(b.times[p], 50) << ", \"p95\": " << percentile(b.times[p], 95) << "}";
+		}
+		out << "}}";
+	}
+	out << "\n  ]\n}" << std::endl;
+}
+
+// Read the benchmarks of a results file written by printJson: one benchmark per line
+static bool readBaseline(const std::string file, std::map<std::string, BaselineEntry>& baseline){
+	std::ifstream in(file);
+	if (!in) { return false; }
+	std::string line;
+	while (std::getline(in, line)) {
+		const size_t name = line.find("{\"name\": \"");
+		if (name == std::string::npos) { continue; }
+		const size_t start = name + 10;
+		BaselineEntry& b = baseline[line.substr(start, line.find('"', start) - start)];
+		b.failed = line.find("\"failed\": true") != std::string::npos;
+		const size_t objective = line.find("\"objective\": [");
+		if (objective != std::string::npos) {
+			std::istringstream fields(line.substr(objective + 14));
+			char comma;
+			fields >> b.objective.first >> comma >> b.objective.second;
+		}
+		for (int p = 0; p < nrPhases; ++p) {
+			const std::string key = "\"" + std::string(phaseNames[p]) + "\": {\"median\": ";
+			const size_t median = line.find(key);
+			if (median != std::string::npos) { b.medians[p] = std::atof(line.c_str() + median + key.size()); }
+		}
+	}
+	return true;
+}
+
+// Report the medians that became slower than the tolerance (in percent), and the changed objectives.
+// Returns the number of regressions.
+static int compare(std::ostream& out, const std::vector<Benchmark>& corpus, const std::map<std::string, BaselineEntry>& baseline, const double tolerance){
+	int regressions = 0;
+	out << std::left << std::setw(24) << "Benchmark" << std::setw(12) << "Phase" << std::setw(16) << "Baseline (ms)" << std::setw(14) << "Median (ms)" << "Change" << std::endl;
+	for (auto& b : corpus) {
+		auto it = baseline.find(b.name);
+		if (it == baseline.end() || it->second.failed || b.failed) {
+			out << std::setw(24) << b.name << (b.failed ? "failed" : "not in baseline") << std::endl;
+			continue;
+		}
+		const BaselineEntry& base = it->second;
+		if (base.objective != b.objective) {
+			out << std::setw(24) << b.name << std::setw(12) << "objective" << std::setw(16) << std::to_string(base.objective.first) + " " + std::to_string(base.objective.second)
+				<< std::setw(14) << std::to_string(b.objective.first) + " " + std::to_string(b.objective.second) << "REGRESSION" << std::endl;
+			regressions++;
+		}
+		for (int p = 0; p < nrPhases; ++p) {
+			const double median = percentile(b.times[p], 50);
+			const double change = (base.medians[p] > 0) ? 100*(median/base.medians[p] - 1) : 0;
+			const bool regressed = change > tolerance && median - base.medians[p] > minRegression;
+			out << std::setw(24) << (p ? "" : b.name) << std::setw(12) << phaseNames[p] << std::fixed << std::setprecision(3) << std::setw(16) << base.medians[p]
+				<< std::setw(14) << median << std::showpos << std::setprecision(1) << change << "%" << std::noshowpos << (regressed ? "  REGRESSION" : "") << std::endl;
+			regressions += regressed;
+		}
+	}
+	out << std::right << std::defaultfloat;
+	return regressions;
+}
+
+int main(int argc, char *argv[])
+{
+	std::string corpusFile = "bench/corpus.txt";
+	std::string jsonFile = "";
+	std::string baselineFile = "";
+	double tolerance = 10;
+	int warmup = 2;
+	int repetitions = 10;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		const std::string option = argv[i];
+		if (option == "-corpus") { corpusFile = argv[i+1]; }
+		else if (option == "-json") { jsonFile = argv[i+1]; }
+		else if (option == "-compare") { baselineFile = argv[i+1]; }
+		else if (option == "-tolerance") { tolerance = std::max(0.0, std::atof(argv[i+1])); }
+		else if (option == "-warmup") { warmup = std::max(0, std::atoi(argv[i+1])); }
+		else if (option == "-reps") { repetitions = std::max(1, std::atoi(argv[i+1])); }
+		else { std::cerr << "Unknown option " << option << "." << std::endl; return 1; }
+	}
+
+	std::vector<Benchmark> corpus = readCorpus(corpusFile);
+	if (corpus.empty()) { return 1; }
+	std::map<std::string, BaselineEntry> baseline;
+	if (!baselineFile.empty() && !readBaseline(baselineFile, baseline)) {
+		std::cerr << "Cannot read benchmark baseline " << baselineFile << "." << std::endl;
+		return 1;
+	}
+
+	std::cout << std::left << std::setw(24) << "Benchmark" << std::setw(12) << "Phase" << std::setw(14) << "Median (ms)" << "P95 (ms)" << std::endl;
+	for (auto& b : corpus) {
+		// Messages of the validator are not part of the report
+		std::cout.setstate(std::ios_base::failbit);
+		for (int r = 0; r < warmup + repetitions && !b.failed; ++r) {
+			run(b, r >= warmup);
+		}
+		std::cout.clear();
+
+		if (b.failed) {
+			std::cout << std::setw(24) << b.name << "failed" << std::endl;
+			continue;
+		}
+		for (int p = 0; p < nrPhases; ++p) {
+			std::cout << std::setw(24) << (p ? "" : b.name) << std::setw(12) << phaseNames[p] << std::fixed << std::setprecision(3)
+				<< std::setw(14) << percentile(b.times[p], 50) << percentile(b.times[p], 95) << std::endl;
+		}
+	}
+	std::cout << std::right << std::defaultfloat;
+	Interface::reset();
+	Instance::reset();
+
+	if (!jsonFile.empty()) {
+		std::ofstream out(jsonFile);
+		if (!out) {
+			std::cerr << "Cannot write benchmark results to " << jsonFile << "." << std::endl;
+			return 1;
+		}
+		printJson(out, corpus, warmup, repetitions);
+	}
+
+	if (!baselineFile.empty()) {
+		std::cout << std::endl << "Compared with " << baselineFile << " (tolerance " << tolerance << "%):" << std::endl;
+		const int regressions = compare(std::cout, corpus, baseline, tolerance);
+		std::cout << regressions << " regression" << (regressions == 1 ? "" : "s") << "." << std::endl;
+		if (regressions > 0) { return 1; }
+	}
+	return 0;
+}
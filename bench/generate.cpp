@@ -0,0 +1,98 @@
+/*********************************************************************************************************
+Instance generator of make scaling
+Writes a random instance and solution of arbitrary size, see Interface::generateScalingInstance
+	-teams		number of teams (even, default 20)
+	-rr		number of round robins (default 2)
+	-slots		number of time slots (default compact: rr*(teams-1)), more slots give a time-relaxed timetable
+	-symmetry	M, I, E, F, P, or NULL (default P)
+	-objective	BM, CO, CR, TR, SC, or NONE (default NONE)
+	-constraints	comma separated list of constraint counts, e.g. CA1Hard=10,SE1Soft=1 (default a mix that grows with the number of teams)
+	-seed		seed of the random generators (default 0)
+	-value		1 to validate the timetable and store its objective value in the solution, 0 to store the unknown value -1,
+			which is much faster for large leagues (default 1)
+	-i, -s		instance and solution file to write
+*********************************************************************************************************/
+
+// Include std
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+// Include other
+#include "ClassInterface.h"
+
+// Parse a comma separated list of name=count pairs
+static bool parseConstraints(const std::string list, std::map<std::string, int>& constraintsMap){
+	std::istringstream in(list);
+	std::string item;
+	while (std::getline(in, item, ',')) {
+		const size_t eq = item.find('=');
+		if (eq == std::string::npos) { return false; }
+		constraintsMap[item.substr(0, eq)] = std::atoi(item.substr(eq+1).c_str());
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	int nrTeams = 20;
+	int nrRoundRobin = 2;
+	int nrSlots = -1;
+	unsigned seed = 0;
+	bool objectiveValue = true;
+	std::string symmetry = "P";
+	std::string objective = "NONE";
+	std::string constraints = "";
+	std::string instanceFile = "";
+	std::string solutionFile = "";
+	for (int i = 1; i + 1 < argc; i += 2) {
+		const std::string option = argv[i];
+		if (option == "-teams") { nrTeams = std::atoi(argv[i+1]); }
+		else if (option == "-rr") { nrRoundRobin = std::atoi(argv[i+1]); }
+		else if (option == "-slots") { nrSlots = std::atoi(argv[i+1]); }
+		else if (option == "-symmetry") { symmetry = argv[i+1]; }
+		else if (option == "-objective") { objective = argv[i+1]; }
+		else if (option == "-constraints") { constraints = argv[i+1]; }
+		else if (option == "-seed") { seed = std::strtoul(argv[i+1], NULL, 10); }
+		else if (option == "-value") { objectiveValue = std::atoi(argv[i+1]) != 0; }
+		else if (option == "-i") { instanceFile = argv[i+1]; }
+		else if (option == "-s") { solutionFile = argv[i+1]; }
+		else { std::cerr << "Unknown option " << option << "." << std::endl; return 1; }
+	}
+	if (nrSlots < 0) { nrSlots = nrRoundRobin*(nrTeams - 1); }
+
+	// Check the arguments
+	if (nrTeams < 2 || nrTeams%2 != 0 || nrRoundRobin < 1 || nrSlots < nrRoundRobin*(nrTeams - 1)) {
+		std::cerr << "Need an even number of teams, at least one round robin, and at least rr*(teams-1) slots." << std::endl;
+		return 1;
+	}
+	if (!GameModeMap.count(symmetry) || !ObjModeMap.count(objective)) {
+		std::cerr << "Unknown symmetry " << symmetry << " or objective " << objective << "." << std::endl;
+		return 1;
+	}
+	if (instanceFile.empty() || solutionFile.empty()) {
+		std::cerr << "No instance or solution file given." << std::endl;
+		return 1;
+	}
+
+	// By default, the number of constraints grows linearly with the number of teams
+	std::map<std::string, int> constraintsMap;
+	if (constraints.empty()) {
+		constraintsMap = {{"CA1Hard", nrTeams/2}, {"CA1Soft", nrTeams/2}, {"CA2Soft", nrTeams/2}, {"CA3Soft", nrTeams/4},
+			{"GA1Soft", nrTeams/4}, {"BR1Soft", nrTeams/4}, {"BR2Soft", 1}, {"FA2Soft", 1}, {"SE1Soft", 1}};
+	} else if (!parseConstraints(constraints, constraintsMap)) {
+		std::cerr << "Invalid constraint list " << constraints << "." << std::endl;
+		return 1;
+	}
+
+	try {
+		Interface::get()->generateScalingInstance(nrTeams, nrRoundRobin, nrSlots, GameModeMap.at(symmetry), ObjModeMap.at(objective), constraintsMap, seed, objectiveValue, instanceFile, solutionFile);
+	} catch(InvalidArgumentException e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	ObjCost obj = Instance::get()->getObjectiveValue();
+	std::cout << instanceFile << ": " << nrTeams << " teams, " << nrSlots << " slots, " << Instance::get()->getCnstrs().size() << " constraints, objective " << obj.first << " " << obj.second << std::endl;
+	return 0;
+}
@@ -0,0 +1,56 @@
+/*********************************************************************************************************
+Coprocess class: evaluate a stream of solutions of one instance over stdin/stdout
+	Meant to be embedded in the search loop of a solver, which starts RobinX once and keeps
+	the pipes open. The instance is loaded once, after which every request only schedules and
+	validates a new solution.
+
+Protocol:
+	Request:	<number of bytes> [<infeasibility bound> <objective bound>]\n<payload>
+			The payload is either a solution XML file, or a list of "home,away,slot" triples.
+			With a bound, evaluation stops as soon as the solution cannot beat it, see Instance::checkConstrBounded.
+	Response:	<infeasibility> <objective> <number of bytes>\n<violation summary>
+			The summary is empty unless RobinX was started with -violations.
+			If the bound was exceeded, the line starts with EXCEEDED and gives the cost so far.
+	On a malformed request the response is "ERROR <number of bytes>\n<message>". A payload that cannot be read
+	completely, e.g. invalid XML or a triple with an unknown team, is answered with ERROR as well, after which
+	the next request is read.
+	Batch:		BATCH <number of solutions>\n followed by that many requests without bound
+			All solutions are read first, and then evaluated by the threads of the coprocess, see
+			Instance::evaluateSchedules. The responses follow in the order of the requests, with an empty summary.
+	All other output of RobinX is sent to stderr.
+*********************************************************************************************************/
+#ifndef CLASSCOPROCESS_H
+#define CLASSCOPROCESS_H
+
+// Include std
+#include <iostream>
+#include <string>
+
+// Include other
+#include "ClassInterface.h"
+
+class Coprocess
+{
+public:
+	Coprocess(const bool violations, const int nrThreads = 1) : violations(violations), nrThreads(nrThreads) {}
+	~Coprocess() {}
+
+	// Answer requests until the input stream is closed
+	void run(std::istream& in, std::ostream& out);
+
+private:
+	// Read the header and payload of a request. Returns false, with the message in payload, on a malformed request
+	bool readRequest(std::istream& in, const std::string& header, ObjCost& bound, std::string& payload);
+	// Answer a batch of n solutions. Returns false if a request of the batch is malformed
+	bool runBatch(std::istream& in, std::ostream& out, const long n);
+	// Replace the solution by the payload. Throws an InterfaceReadingException if the payload cannot be read.
+	void read(const std::string& payload);
+	// Evaluate a single solution payload within the bound, and write the summary if requested.
+	// Throws an InterfaceReadingException if the payload cannot be read.
+	ObjCost evaluate(const std::string& payload, const ObjCost bound, bool& exceeded, std::string& summary);
+
+	bool violations;
+	int nrThreads; 		// Threads that evaluate a batch
+};
+
+#endif /* CLASSCOPROCESS_H */
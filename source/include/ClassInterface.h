@@ -14,6 +14,9 @@ Singleton pattern:
 #ifndef CLASSFACTORY_H
 #define CLASSFACTORY_H
 
+// Include std
+#include <memory>
+
 // Include other
 #include "../validator/Globals.h"
 #include "../validator/ClassInstance.h"
@@ -22,6 +25,8 @@ Singleton pattern:
 #include "tinyXMLParser.h"
 #include "ClassException.h"
 
+class ScheduleState;
+
 class Interface
 {
 public:
@@ -54,6 +59,11 @@ public:
 	// Constraints
 	void addConstraint(Constraint* c);
 	ObjCost checkConstr(bool silent=false);
+	bool checkConstrBounded(const ObjCost bound, bool silent=true);
+	ObjCost reweigh();
+	// Snapshot of the current schedule, and the cost of many snapshots evaluated by nrThreads threads, see Instance
+	std::shared_ptr<ScheduleState> getSchedule();
+	std::vector<ObjCost> evaluateSchedules(const std::vector<std::shared_ptr<ScheduleState>>& schedules, const int nrThreads);
 
 	// Classify
 	std::string classify();
@@ -65,13 +75,21 @@ public:
 
 	// Parser
 	void addInstanceName(const std::string name, const std::string schema = "");
-	void readInstanceXml(std::string xmlFile, std::string xmlSchema = "");	
+	// Returns false if the file could not be parsed completely
+	bool readInstanceXml(std::string xmlFile, std::string xmlSchema = "");	
 	void readInstanceXmlString(std::string xmlContent, std::string xmlSchema = "");	
 	void writeInstanceXml(std::string xmlFile);
 	void addSolutionName(const std::string name, const std::string schema = "");
 	void readSolutionXml(std::string xmlFile, std::string xmlSchemaIn = "", std::string xmlSchemaSol = "", bool readIn=false);
 	void readSolutionXmlString(std::string xmlContent, std::string xmlSchemaIn = "", std::string xmlSchemaSol = "", bool readIn=false);
+	// Forget the solution, such that the next solution of the same instance gives the same result as in a fresh process
+	void resetSolution();
 	void writeSolutionXml(std::string xmlFile);
+	void readSolutionTriplesString(std::string content);
+	void readSolutionCsv(std::string csvFile);
+	void writeSolutionCsv(std::string csvFile);
+	void readSolutionBinary(std::string binFile);
+	void writeSolutionBinary(std::string binFile);
 	void writeBoundXml(std::string xmlFile);
 	
 	// Meta data	
@@ -94,6 +112,9 @@ public:
 	/// Generate a random timetable
 	std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> randomVizing(const int nrTeams, const int nrRoundRobin, const GameMode symmetry);	
 
+	/// Generate a random instance and solution of arbitrary size, written to fileName and solName
+	void generateScalingInstance(const int nrTeams, const int nrRoundRobin, const int nrSlots, const GameMode symmetry, const ObjMode objMode, const std::map<std::string, int> constraintsMap, const unsigned seed, const bool objectiveValue, std::string fileName, std::string solName);
+
 	/// Generate a random timetable by enumerating patterns
 	// TODO This function requires cplex, and is therefore temporary disabled (for github online version)
 	//std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> randomPattern(const int nrTeams, const int nrRoundRobin, const GameMode symmetry, const bool max3HomeAway, const bool max4Breaks);	
@@ -0,0 +1,77 @@
+/*********************************************************************************************************
+Server class: validation daemon listening on a local Unix socket
+	Parsed instances are kept in an LRU cache keyed by path, modification time, and content hash.
+	Every request is validated by a forked worker process, so that the singleton Instance and the
+	global output streams of a worker never interfere with other requests. Forking shares the
+	cached instances copy-on-write with the workers.
+
+Protocol (one request per connection):
+	<path of the instance XML file>\n
+	<number of bytes in the solution>\n
+	<solution XML>
+The worker answers with the violated constraints followed by a line "Objective: <inf> <obj>",
+and closes the connection.
+*********************************************************************************************************/
+#ifndef CLASSSERVER_H
+#define CLASSSERVER_H
+
+// Include std
+#include <string>
+#include <list>
+#include <map>
+#include <ctime>
+
+// Include other
+#include "ClassInterface.h"
+
+// Cache of parsed instances, least recently used instance is evicted first
+class InstanceCache
+{
+public:
+	InstanceCache(const int capacity) : capacity(capacity) {}
+	~InstanceCache();
+
+	// Return the instance stored under a path, and (re)load it if the file changed since it was cached
+	Instance* get(const std::string path);
+	int size() const { return entries.size(); }
+
+private:
+	struct Entry {
+		std::string path;
+		struct timespec mtime;
+		off_t size;
+		uint64_t hash;
+		Instance* instance;
+	};
+	typedef std::list<Entry> EntryList;
+
+	Instance* load(const std::string path);
+	void evict();
+
+	int capacity;
+	EntryList entries; 						// Most recently used entry in front
+	std::map<std::string, EntryList::iterator> index; 	// Path to cache entry
+};
+
+class Server
+{
+public:
+	Server(const std::string socketPath, const int nrWorkers, const int cacheSize) : socketPath(socketPath), nrWorkers(nrWorkers), cache(cacheSize) {}
+	~Server();
+
+	// Accept and validate requests until the process is killed
+	void run();
+
+private:
+	void handle(const int client);
+	void serve(const int client, Instance* instance, const long length);
+	void reapWorkers(bool block);
+
+	std::string socketPath;
+	int nrWorkers;
+	int nrActive = 0; 			// Number of running worker processes
+	int listenFd = -1;
+	InstanceCache cache;
+};
+
+#endif /* CLASSSERVER_H */
@@ -65,14 +65,14 @@ public:
 //	/*******************
 //	*  Serialization  *
 //	*******************/
-	// From data structure to XML
+	// From data structure to XML: elements are streamed to the file without building a document
 	void serializeInstance(std::string fileName);
 	void serializeSolution(std::string fileName);
 	void serializeBound(std::string fileName);
 
-	
-	tinyxml2::XMLElement* serialize(AttrMap attrs);
-	void serializeGames();
+	FILE* openXml(std::string fileName);
+	void serialize(tinyxml2::XMLPrinter& printer, const AttrMap& attrs);
+	void serializeGames(tinyxml2::XMLPrinter& printer);
 
 
 public:
@@ -94,7 +94,7 @@ public:
 	SlotPairList detokenizeSlotPairs(std::string str);
 		
 	// Add a node
-	void addChildNode(tinyxml2::XMLElement* parentNode, std::string childStr, std::string content="");
+	void addChildNode(tinyxml2::XMLPrinter& printer, const char* childStr, std::string content="");
 
 	/*********************
 	*  Deserialization  *
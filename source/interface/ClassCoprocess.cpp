@@ -0,0 +1,144 @@
+#include "ClassCoprocess.h"
+
+// Include std
+#include <sstream>
+#include <vector>
+
+void Coprocess::run(std::istream& in, std::ostream& out){
+	std::string header;
+	while (std::getline(in, header)) {
+		if (header.empty()) { continue; }
+
+		if (header.compare(0, 6, "BATCH ") == 0) {
+			long n = -1;
+			std::string rest;
+			std::istringstream fields(header.substr(6));
+			if (!(fields >> n) || fields >> rest || n < 0) {
+				const std::string msg = "Invalid batch header '" + header + "'.";
+				out << "ERROR " << msg.size() << "\n" << msg << std::flush;
+				return;
+			}
+			if (!runBatch(in, out, n)) { return; }
+			continue;
+		}
+
+		std::string payload;
+		ObjCost bound = std::make_pair(-1,-1);
+		if (!readRequest(in, header, bound, payload)) {
+			if (!payload.empty()) { out << "ERROR " << payload.size() << "\n" << payload << std::flush; }
+			return;
+		}
+
+		std::string summary;
+		bool exceeded = false;
+		ObjCost obj;
+		try {
+			obj = evaluate(payload, bound, exceeded, summary);
+		} catch(InterfaceReadingException e) {
+			// The solution was not read completely: do not report the cost of the games read so far
+			const std::string msg = e.what();
+			out << "ERROR " << msg.size() << "\n" << msg << std::flush;
+			continue;
+		}
+		out << (exceeded ? "EXCEEDED " : "") << obj.first << " " << obj.second << " " << summary.size() << "\n" << summary << std::flush;
+	}
+}
+
+bool Coprocess::readRequest(std::istream& in, const std::string& header, ObjCost& bound, std::string& payload){
+	// The bound is optional, -1 means unbounded
+	long length = -1;
+	std::istringstream fields(header);
+	if (!(fields >> length) || (fields >> bound.first && !(fields >> bound.second))) {
+		length = -1;
+	}
+	if (length < 0) {
+		payload = "Invalid request header '" + header + "'.";
+		return false;
+	}
+
+	payload.assign(length, '\0');
+	if (!in.read(&payload[0], length)) {
+		payload.clear();
+		return false;
+	}
+	return true;
+}
+
+bool Coprocess::runBatch(std::istream& in, std::ostream& out, const long n){
+	// Read all solutions on this thread: every solution is a snapshot of the schedule, which the next one does not change
+	std::vector<std::shared_ptr<ScheduleState>> schedules;
+	std::vector<std::string> errors(n);
+	std::vector<int> index(n, -1);
+	std::string header;
+	for (long i = 0; i < n; ++i) {
+		while (std::getline(in, header) && header.empty()) {}
+		if (!in) { return false; }
+		std::string payload;
+		ObjCost bound = std::make_pair(-1,-1);
+		if (!readRequest(in, header, bound, payload)) {
+			if (!payload.empty()) { out << "ERROR " << payload.size() << "\n" << payload << std::flush; }
+			return false;
+		}
+		if (bound.first != -1 || bound.second != -1) {
+			const std::string msg = "Invalid request header '" + header + "': the requests of a batch have no bound.";
+			out << "ERROR " << msg.size() << "\n" << msg << std::flush;
+			return false;
+		}
+		try {
+			read(payload);
+		} catch(InterfaceReadingException e) {
+			errors[i] = e.what();
+			continue;
+		}
+		index[i] = schedules.size();
+		schedules.push_back(Interface::get()->getSchedule());
+	}
+
+	const std::vector<ObjCost> costs = Interface::get()->evaluateSchedules(schedules, nrThreads);
+	for (long i = 0; i < n; ++i) {
+		if (index[i] == -1) {
+			out << "ERROR " << errors[i].size() << "\n" << errors[i];
+		} else {
+			out << costs[index[i]].first << " " << costs[index[i]].second << " 0\n";
+		}
+	}
+	out << std::flush;
+	return true;
+}
+
+void Coprocess::read(const std::string& payload){
+	// Forget the previous solution
+	Interface::get()->resetSolution();
+
+	// XML payloads start with a tag, anything else is a list of triples
+	Profiler::Phase phase("parsing");
+	size_t first = payload.find_first_not_of(" \t\r\n");
+	if (first != std::string::npos && payload[first] == '<') {
+		Interface::get()->readSolutionXmlString(payload);
+	} else {
+		Interface::get()->readSolutionTriplesString(payload);
+	}
+}
+
+ObjCost Coprocess::evaluate(const std::string& payload, const ObjCost bound, bool& exceeded, std::string& summary){
+	read(payload);
+
+	// Collect the violations printed by the constraints
+	std::stringstream report;
+	std::streambuf* prev = NULL;
+	if (violations) { prev = std::cout.rdbuf(report.rdbuf()); }
+
+	ObjCost obj;
+	if (bound.first == -1 && bound.second == -1) {
+		obj = Interface::get()->checkConstr(!violations);
+	} else {
+		exceeded = !Interface::get()->checkConstrBounded(bound, !violations);
+		obj = Instance::get()->getObjectiveValue();
+	}
+
+	if (violations) {
+		std::cout.rdbuf(prev);
+		summary = report.str();
+	}
+	return obj;
+}
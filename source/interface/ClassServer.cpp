@@ -0,0 +1,287 @@
+#include "ClassServer.h"
+
+// Include std
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+
+// Include POSIX
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Maximum length of a header line of a request
+#define MAX_HEADER_LENGTH 4096
+
+// Read one newline-terminated line from a socket
+static bool readLine(const int fd, std::string& line){
+	line.clear();
+	char c;
+	while (line.size() < MAX_HEADER_LENGTH) {
+		const ssize_t n = recv(fd, &c, 1, 0);
+		if (n < 0 && errno == EINTR) { continue; }
+		if (n <= 0) { return false; }
+		if (c == '\n') { return true; }
+		line += c;
+	}
+	return false;
+}
+
+// Read exactly length bytes from a socket
+static bool readBytes(const int fd, char* buffer, long length){
+	while (length > 0) {
+		const ssize_t n = recv(fd, buffer, length, 0);
+		if (n < 0 && errno == EINTR) { continue; }
+		if (n <= 0) { return false; }
+		buffer += n;
+		length -= n;
+	}
+	return true;
+}
+
+static void writeString(const int fd, const std::string str){
+	const char* buffer = str.c_str();
+	size_t length = str.size();
+	while (length > 0) {
+		const ssize_t n = write(fd, buffer, length);
+		if (n < 0 && errno == EINTR) { continue; }
+		if (n <= 0) { return; }
+		buffer += n;
+		length -= n;
+	}
+}
+
+// Answer with an error message, and discard the rest of the request so that the client can read it
+static void reject(const int fd, const std::string msg){
+	writeString(fd, msg);
+	shutdown(fd, SHUT_WR);
+	char buffer[4096];
+	while (recv(fd, buffer, sizeof(buffer), 0) > 0) {}
+}
+
+/*****************
+* Instance cache *
+*****************/
+
+// Makes a fresh instance object the active one while it is parsed. The previously active instance is restored
+// on every exit path, and the fresh one is freed unless it was released.
+class ActiveInstanceGuard
+{
+public:
+	ActiveInstanceGuard() : prev(Instance::swap(NULL)) {}
+	~ActiveInstanceGuard() {
+		if (!released) { Instance::destroy(Instance::swap(prev)); }
+	}
+
+	// Restore the previously active instance, and hand over the fresh one
+	Instance* release() {
+		released = true;
+		return Instance::swap(prev);
+	}
+
+private:
+	Instance* prev;
+	bool released = false;
+};
+
+InstanceCache::~InstanceCache(){
+	for (auto e : entries) {
+		Instance::destroy(e.instance);
+	}
+}
+
+Instance* InstanceCache::get(const std::string path){
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0) {
+		throw_line_robinx(FileNotFoundException, "Cannot find instance file " + path + ".");
+	}
+
+	auto it = index.find(path);
+	if (it != index.end()) {
+		EntryList::iterator e = it->second;
+		if (e->mtime.tv_sec != st.st_mtim.tv_sec || e->mtime.tv_nsec != st.st_mtim.tv_nsec || e->size != st.st_size) {
+			// File was touched: only reload when the content changed
+			const uint64_t hash = hashFile(path);
+			if (hash != e->hash) {
+				Instance::destroy(e->instance);
+				index.erase(it);
+				entries.erase(e);
+				return load(path);
+			}
+			e->mtime = st.st_mtim;
+			e->size = st.st_size;
+		}
+		// Mark as most recently used
+		entries.splice(entries.begin(), entries, e);
+		return e->instance;
+	}
+	return load(path);
+}
+
+Instance* InstanceCache::load(const std::string path){
+	struct stat st;
+	stat(path.c_str(), &st);
+
+	const uint64_t hash = hashFile(path);
+
+	// Parse into a fresh instance object, and restore the previously active one afterwards
+	ActiveInstanceGuard guard;
+	if (!Interface::get()->readInstanceXml(path)) {
+		throw_line_robinx(InterfaceReadingException, "Cannot parse instance file " + path + ".");
+	}
+	Instance* loaded = guard.release();
+
+	while (!entries.empty() && (int) entries.size() >= capacity) {
+		evict();
+	}
+	Entry e = {path, st.st_mtim, st.st_size, hash, loaded};
+	entries.push_front(e);
+	index[path] = entries.begin();
+	return loaded;
+}
+
+void InstanceCache::evict(){
+	Entry& e = entries.back();
+	Instance::destroy(e.instance);
+	index.erase(e.path);
+	entries.pop_back();
+}
+
+/*********
+* Server *
+*********/
+
+Server::~Server(){
+	if (listenFd >= 0) {
+		close(listenFd);
+		unlink(socketPath.c_str());
+	}
+}
+
+void Server::run(){
+	struct sockaddr_un addr;
+	if (socketPath.size() >= sizeof(addr.sun_path)) {
+		throw_line_robinx(InvalidArgumentException, "Socket path " + socketPath + " is too long.");
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+	listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(socketPath.c_str());
+	if (listenFd < 0 || bind(listenFd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(listenFd, SOMAXCONN) != 0) {
+		throw_line_robinx(InvalidArgumentException, "Cannot listen on socket " + socketPath + ": " + strerror(errno));
+	}
+
+	// Clients that hang up should not kill the server
+	signal(SIGPIPE, SIG_IGN);
+
+	std::cout << "Listening on " << socketPath << " with " << nrWorkers << " workers." << std::endl;
+	while (true) {
+		const int client = accept(listenFd, NULL, NULL);
+		if (client < 0) {
+			if (errno != EINTR) {
+				std::cerr << "Accept failed: " << strerror(errno) << std::endl;
+			}
+			continue;
+		}
+		handle(client);
+		close(client);
+		reapWorkers(false);
+	}
+}
+
+void Server::handle(const int client){
+	// Do not let a silent client block the server
+	struct timeval timeout = {10, 0};
+	setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	std::string path, length;
+	if (!readLine(client, path) || !readLine(client, length)) {
+		reject(client, "Error: malformed request header.\n");
+		return;
+	}
+
+	long nrBytes;
+	try {
+		nrBytes = std::stol(length);
+	} catch (std::exception e) {
+		nrBytes = -1;
+	}
+	if (nrBytes < 0) {
+		reject(client, "Error: invalid solution length " + length + ".\n");
+		return;
+	}
+
+	Instance* instance;
+	try {
+		instance = cache.get(path);
+	} catch (RuntimeException e) {
+		reject(client, e.what() + "\n");
+		return;
+	} catch (std::exception& e) {
+		reject(client, "Error: cannot load instance " + path + ": " + e.what() + "\n");
+		return;
+	}
+
+	// Wait for a free worker
+	while (nrActive >= nrWorkers) {
+		reapWorkers(true);
+	}
+
+	// Buffered output would otherwise be written twice
+	std::cout.flush();
+	std::cerr.flush();
+	const pid_t pid = fork();
+	if (pid < 0) {
+		reject(client, "Error: cannot start worker.\n");
+	} else if (pid == 0) {
+		serve(client, instance, nrBytes);
+	} else {
+		nrActive++;
+	}
+}
+
+void Server::serve(const int client, Instance* instance, const long length){
+	// Worker process: never returns
+	close(listenFd);
+	std::string solution(length, '\0');
+	if (!readBytes(client, &solution[0], length)) {
+		writeString(client, "Error: incomplete solution.\n");
+		_exit(1);
+	}
+
+	// Report everything over the connection
+	dup2(client, STDOUT_FILENO);
+	dup2(client, STDERR_FILENO);
+
+	// The worker owns a copy-on-write image of the cached instance
+	Instance::swap(instance);
+	try {
+		Interface::get()->readSolutionXmlString(solution);
+	} catch(InterfaceReadingException e) {
+		std::cout << "Error: " << e.what() << std::endl;
+		_exit(1);
+	}
+	ObjCost obj = Interface::get()->checkConstr(false);
+	std::cout << "Objective: " << obj.first << " " << obj.second << std::endl;
+	std::cerr.flush();
+	_exit(0);
+}
+
+void Server::reapWorkers(bool block){
+	while (nrActive > 0) {
+		const pid_t pid = waitpid(-1, NULL, block ? 0 : WNOHANG);
+		if (pid > 0) {
+			nrActive--;
+			block = false;
+		} else if (pid < 0 && errno == EINTR) {
+			continue;
+		} else {
+			return;
+		}
+	}
+}
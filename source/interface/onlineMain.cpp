@@ -1,8 +1,11 @@
 // Include std
 #include <iostream>
+#include <fstream>
 
 // Include other
 #include "ClassInterface.h"
+#include "ClassServer.h"
+#include "ClassCoprocess.h"
 
 // Input parser class, see: https://stackoverflow.com/questions/865668/how-to-parse-command-line-arguments-in-c#868894
 class InputParser{
@@ -31,8 +34,63 @@ class InputParser{
 };
 
 
+// Compact schedule files are recognised by their extension
+bool hasExtension(const std::string& file, const std::string& ext){
+	return file.size() >= ext.size() && file.compare(file.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+// Report the profile on stdout, or as JSON in the file given by -profileJson
+void writeProfile(const InputParser& input){
+	if (input.cmdOptionExists("-profile")) {
+		Profiler::get()->print(std::cout);
+	}
+	if (input.cmdOptionExists("-profileJson")) {
+		const std::string file = input.getCmdOption("-profileJson");
+		std::ofstream out(file);
+		if (!out) {
+			std::cerr << "Cannot write profile to " << file << "." << std::endl;
+			return;
+		}
+		Profiler::get()->printJson(out);
+	}
+}
+
+// Report the meeting query counters on stdout, or as JSON in the file given by -queriesJson
+void writeQueries(const InputParser& input){
+	if (input.cmdOptionExists("-queries")) {
+		Instance::get()->printQueryStats(std::cout);
+	}
+	if (input.cmdOptionExists("-queriesJson")) {
+		const std::string file = input.getCmdOption("-queriesJson");
+		std::ofstream out(file);
+		if (!out) {
+			std::cerr << "Cannot write query counters to " << file << "." << std::endl;
+			return;
+		}
+		Instance::get()->printQueryStatsJson(out);
+	}
+}
+
+void writeTrace(const std::string file){
+	std::ofstream out(file);
+	if (!out) {
+		std::cerr << "Cannot write trace to " << file << "." << std::endl;
+		return;
+	}
+	Tracer::get()->write(out);
+}
+
 int main(int argc, char *argv[])
 {
+	InputParser input(argc, argv);
+
+	// In coprocess mode, stdout is reserved for the answers: send everything else to stderr
+	std::ostream protocol(std::cout.rdbuf());
+	const bool coprocess = input.cmdOptionExists("-coprocess");
+	if (coprocess) {
+		std::cout.rdbuf(std::cerr.rdbuf());
+	}
+
 	// Display welcome text
 	std::string welcomeText = "RobinX Validator 2.0\nGNU General Public License v3.0.\nSee the README for more details or type '-h' for more help.\n";
 	std::cout << welcomeText << std::endl;
@@ -45,20 +103,82 @@ int main(int argc, char *argv[])
 
 	// Read arguments
 	bool validation = true; // Set to true if enough information to validate.
-	InputParser input(argc, argv);
 	if(input.cmdOptionExists("-h")){
 		std::cout << "Help argument enabled." << std::endl;
 		std::cout << "The following arguments are available:" << std::endl;
-		const int width = 10;
+		const int width = 14;
 		std::cout << std::left << std::setw(width) << "-i" << "Name of the instance XML file." << std::endl;
-		std::cout << std::left << std::setw(width) << "-s" << "Name of the solution XML file. If no instance file is given, RobinX retrieves instance path given in solution file." << std::endl;
+		std::cout << std::left << std::setw(width) << "-s" << "Name of the solution XML file. If no instance file is given, RobinX retrieves instance path given in solution file. Files ending on .csv or .rbs are read as compact schedules, which require an instance file." << std::endl;
 		std::cout << std::left << std::setw(width) << "-iString" << "String without spaces giving the content of the instance XML file." << std::endl;
 		std::cout << std::left << std::setw(width) << "-sString" << "String without spaces giving the content of the solution XML file. If no instance file is given, RobinX retrieves instance path given in solution file." << std::endl;
+		std::cout << std::left << std::setw(width) << "-o" << "Write the validated solution to this file: a compact schedule if it ends on .csv or .rbs, XML otherwise." << std::endl;
+		std::cout << std::left << std::setw(width) << "-server" << "Path of a Unix socket on which RobinX keeps running as a validation server. See the README for the protocol." << std::endl;
+		std::cout << std::left << std::setw(width) << "-workers" << "Number of solutions the server validates concurrently (default 4)." << std::endl;
+		std::cout << std::left << std::setw(width) << "-cache" << "Number of parsed instances the server keeps in memory (default 16)." << std::endl;
+		std::cout << std::left << std::setw(width) << "-coprocess" << "Load the instance given by -i or -iString, and evaluate solutions read from stdin until it is closed. See the README for the protocol." << std::endl;
+		std::cout << std::left << std::setw(width) << "-violations" << "In coprocess mode, also return the violated constraints of every solution." << std::endl;
+		std::cout << std::left << std::setw(width) << "-threads" << "In coprocess mode, number of threads that evaluate the solutions of a batch (default 1)." << std::endl;
+		std::cout << std::left << std::setw(width) << "-profile" << "Print the time spent in every phase and constraint type, and the slowest constraints." << std::endl;
+		std::cout << std::left << std::setw(width) << "-profileJson" << "Write the time spent in every phase, constraint type, and constraint as JSON to this file." << std::endl;
+		std::cout << std::left << std::setw(width) << "-queries" << "Print how often every meeting query was called, and how many meetings it visited and returned, in total and per constraint." << std::endl;
+		std::cout << std::left << std::setw(width) << "-queriesJson" << "Write the meeting query counters as JSON to this file." << std::endl;
+		std::cout << std::left << std::setw(width) << "-trace" << "Write a timeline of the parser steps, validation phases, and constraints to this file, in the Chrome trace-event format." << std::endl;
 		std::cout << std::left << std::setw(width) << "-h" << "Print the content of this help message." << std::endl;
 		return 0;
 	}
 
+	const bool profile = input.cmdOptionExists("-profile") || input.cmdOptionExists("-profileJson");
+	Profiler::get()->setEnabled(profile);
+	const bool trace = input.cmdOptionExists("-trace");
+	Tracer::get()->setEnabled(trace);
+	const bool queries = input.cmdOptionExists("-queries") || input.cmdOptionExists("-queriesJson");
+
+	if(input.cmdOptionExists("-server")){
+		int nrWorkers = 4;
+		int cacheSize = 16;
+		try {
+			if (input.cmdOptionExists("-workers")) { nrWorkers = std::max(1, std::stoi(input.getCmdOption("-workers"))); }
+			if (input.cmdOptionExists("-cache")) { cacheSize = std::max(1, std::stoi(input.getCmdOption("-cache"))); }
+			Server server(input.getCmdOption("-server"), nrWorkers, cacheSize);
+			server.run();
+		} catch(RuntimeException e) {
+			std::cerr << e.what() << std::endl;
+		} catch(std::exception e) {
+			std::cerr << "Invalid number of workers or cache size." << std::endl;
+		}
+		return 1;
+	}
+
+	if(coprocess){
+		try {
+			Profiler::Phase phase("parsing");
+			if(input.cmdOptionExists("-i")){
+				Interface::get()->readInstanceXml(input.getCmdOption("-i"));
+			} else if (input.cmdOptionExists("-iString")) {
+				Interface::get()->readInstanceXmlString(input.getCmdOption("-iString"));
+			} else {
+				throw_line_robinx(InterfaceReadingException, "Coprocess mode requires an instance file.");
+			}
+		}catch(InterfaceReadingException e) {
+			std::cerr << e.what() << std::endl;
+			return 1;
+		}
+		int nrThreads = 1;
+		try {
+			if (input.cmdOptionExists("-threads")) { nrThreads = std::max(1, std::stoi(input.getCmdOption("-threads"))); }
+		} catch(std::exception e) {
+			std::cerr << "Invalid number of threads." << std::endl;
+			return 1;
+		}
+		Coprocess(input.cmdOptionExists("-violations"), nrThreads).run(std::cin, protocol);
+		if (profile) { writeProfile(input); }
+		if (queries) { writeQueries(input); }
+		if (trace) { writeTrace(input.getCmdOption("-trace")); }
+		return 0;
+	}
+
 	try {
+		Profiler::Phase phase("parsing");
 		bool readIn = false; // True if instance path need to be retrieved from the solution file
 		if(input.cmdOptionExists("-i")){
 			assert(!input.cmdOptionExists("-iString"));
@@ -75,7 +195,18 @@ int main(int argc, char *argv[])
 		if(input.cmdOptionExists("-s")){
 			assert(!input.cmdOptionExists("-sString"));
 			solutionFile = input.getCmdOption("-s");
-			Interface::get()->readSolutionXml(solutionFile, "", "", readIn);
+			if (hasExtension(solutionFile, ".csv") || hasExtension(solutionFile, ".rbs")) {
+				if (readIn) {
+					throw_line_robinx(InterfaceReadingException, "Compact schedule " + solutionFile + " requires an instance file.");
+				}
+				if (hasExtension(solutionFile, ".csv")) {
+					Interface::get()->readSolutionCsv(solutionFile);
+				} else {
+					Interface::get()->readSolutionBinary(solutionFile);
+				}
+			} else {
+				Interface::get()->readSolutionXml(solutionFile, "", "", readIn);
+			}
 		} else if (input.cmdOptionExists("-sString")){
 			solutionString = input.getCmdOption("-sString");
 			Interface::get()->readSolutionXmlString(solutionString, "", "", readIn);
@@ -96,6 +227,20 @@ int main(int argc, char *argv[])
 		std::cout << "       -------------------------------------------------------------------" << std::endl;
 		std::cout << std::setw(30) << std::left << "       Objective:"  << std::setw(20) << obj.first << std::setw(10) << obj.second << std::right << std::endl;
 		std::cout << "       -------------------------------------------------------------------" << std::endl;
+		if (profile) { writeProfile(input); }
+		if (queries) { writeQueries(input); }
+		if (trace) { writeTrace(input.getCmdOption("-trace")); }
+
+		if(input.cmdOptionExists("-o")){
+			const std::string outFile = input.getCmdOption("-o");
+			if (hasExtension(outFile, ".csv")) {
+				Interface::get()->writeSolutionCsv(outFile);
+			} else if (hasExtension(outFile, ".rbs")) {
+				Interface::get()->writeSolutionBinary(outFile);
+			} else {
+				Interface::get()->writeSolutionXml(outFile);
+			}
+		}
 		return obj.second;
 	} else {
 		std::cout << "Some error occurred. Validation was canceled."  << std::endl;
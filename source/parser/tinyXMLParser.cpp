@@ -1,16 +1,26 @@
 #include "tinyXMLParser.h"
 
 void TinyParser::readFile(const std::string fileName){
+	Tracer::Span span("parseXml", "parser");
 	tinyxml2::XMLError eResult = doc->LoadFile(fileName.c_str());
 	XMLCheckResult(eResult);
+	if (eResult != tinyxml2::XML_SUCCESS || doc->RootElement() == NULL) {
+		throw_line_robinx(XmlReadingException, "Cannot read XML file " + fileName + ": " + doc->ErrorStr() + "\n");
+	}
 	return;
 }
 
 void TinyParser::readString(const std::string content){
-	doc->Parse(content.c_str());
+	Tracer::Span span("parseXml", "parser");
+	if (doc->Parse(content.c_str()) != tinyxml2::XML_SUCCESS || doc->RootElement() == NULL) {
+		throw_line_robinx(XmlReadingException, std::string("Invalid XML: ") + doc->ErrorStr() + "\n");
+	}
 	return;
 }
 
+// Declaration of a new tinyxml2 document
+static const char* XML_DECLARATION = "xml version=\"1.0\" encoding=\"UTF-8\"";
+
 void TinyParser::saveXml(const std::string docName){
 	doc->SaveFile(docName.c_str());
 	return;
@@ -106,10 +116,10 @@ std::array<IdList, 2> TinyParser::readSlotTags(const tinyxml2::XMLElement* c, in
 	return tags;
 }
 
-void TinyParser::addChildNode(tinyxml2::XMLElement* parentNode, std::string childStr, std::string content){
-	tinyxml2::XMLElement* el = doc->NewElement(childStr.c_str());
-	el->SetText(content.c_str());
-	parentNode->InsertEndChild(el);
+void TinyParser::addChildNode(tinyxml2::XMLPrinter& printer, const char* childStr, std::string content){
+	printer.OpenElement(childStr);
+	printer.PushText(content.c_str());
+	printer.CloseElement();
 }
 
 void TinyParser::deserializeInstance(){
@@ -156,6 +166,10 @@ void TinyParser::deserializeSolution(const bool readIn){
 
 		// Read games
 		readGames();
+	} catch (const RuntimeException& e){
+		std::stringstream msg;
+		msg << "Deserialization of solution resulted in exception: \n" << e.what() << std::endl;
+		throw_line_robinx(XmlReadingException, msg.str());
 	} catch (...){
 		std::stringstream msg;
 		msg << "Unknown exception during parsing." << std::endl;
@@ -165,6 +179,7 @@ void TinyParser::deserializeSolution(const bool readIn){
 }
 
 void TinyParser::readGames(){
+	Tracer::Span span("readGames", "parser");
 	// Get root node and add all matches
 	tinyxml2::XMLElement* root = doc->RootElement();	
 
@@ -178,6 +193,7 @@ void TinyParser::readGames(){
 }
 
 void TinyParser::readMetaDataSol(){
+	Tracer::Span span("readMetaDataSol", "parser");
 	Interface *f = Interface::get();
 
 	tinyxml2::XMLElement* metaData = nullptr;
@@ -239,6 +255,7 @@ void TinyParser::readMetaDataSol(){
 }
 
 void TinyParser::readMetaData() { 
+	Tracer::Span span("readMetaData", "parser");
 	Interface *f = Interface::get();
 	tinyxml2::XMLElement* metaData = nullptr;
         metaData = doc->RootElement()->FirstChildElement("MetaData");	
@@ -299,6 +316,7 @@ void TinyParser::readMetaData() {
 }
 
 void TinyParser::readData() {
+	Tracer::Span span("readData", "parser");
 	readDistances();
 	readCOEWeights();
 	readCosts();
@@ -344,12 +362,14 @@ void TinyParser::readCosts() {
 }
 
 void TinyParser::readObjectiveFunction() {
+	Tracer::Span span("readObjectiveFunction", "parser");
 	// Get objective element
 	tinyxml2::XMLElement* obj = doc->RootElement()->FirstChildElement("ObjectiveFunction");	
 	Interface::get()->addObjective(ObjModeMap.at(obj->FirstChildElement("Objective")->GetText()));
 }
 
 void TinyParser::readLeagues() {
+	Tracer::Span span("readLeagues", "parser");
 	// Get leagues element
 	tinyxml2::XMLElement* leagues = doc->RootElement()->FirstChildElement("Resources")->FirstChildElement("Leagues");	
 
@@ -424,6 +444,7 @@ void TinyParser::readLeagues() {
 	}
 }
 void TinyParser::readSlots() {
+	Tracer::Span span("readSlots", "parser");
 	tinyxml2::XMLElement* slots = doc->RootElement()->FirstChildElement("Resources")->FirstChildElement("Slots");	
 	// Load all slots into memory
 	for (const tinyxml2::XMLElement* p = slots->FirstChildElement("slot"); p; p = p->NextSiblingElement("slot")) {
@@ -433,6 +454,7 @@ void TinyParser::readSlots() {
 	}
 }
 void TinyParser::readSlotGroups() {
+	Tracer::Span span("readSlotGroups", "parser");
 	tinyxml2::XMLElement* slotGroups = nullptr;
 	slotGroups = doc->RootElement()->FirstChildElement("Resources")->FirstChildElement("SlotGroups");	
 	if(slotGroups != nullptr){
@@ -444,6 +466,7 @@ void TinyParser::readSlotGroups() {
 	}
 }
 void TinyParser::readTeams() {
+	Tracer::Span span("readTeams", "parser");
 	tinyxml2::XMLElement* teams = doc->RootElement()->FirstChildElement("Resources")->FirstChildElement("Teams");	
 	// Load all slot groups into memory
 	for (const tinyxml2::XMLElement* p = teams->FirstChildElement("team"); p; p = p->NextSiblingElement("team")) {
@@ -453,6 +476,7 @@ void TinyParser::readTeams() {
 	}
 }
 void TinyParser::readAdditionalGames() {
+	Tracer::Span span("readAdditionalGames", "parser");
 	tinyxml2::XMLElement* games = nullptr;
 	games = doc->RootElement()->FirstChildElement("Structure")->FirstChildElement("AdditionalGames");	
 	if (games != nullptr) {
@@ -466,6 +490,7 @@ void TinyParser::readAdditionalGames() {
 
 
 void TinyParser::readTeamGroups() {
+	Tracer::Span span("readTeamGroups", "parser");
 	// Get list of all team group nodes
 	tinyxml2::XMLElement* teamGroups = nullptr;
 	teamGroups = doc->RootElement()->FirstChildElement("Resources")->FirstChildElement("TeamGroups");	
@@ -479,6 +504,7 @@ void TinyParser::readTeamGroups() {
 	}
 }
 void TinyParser::readConstr() {
+	Tracer::Span span("readConstr", "parser");
 	readBaseConstr();
 	readCapacityConstr();
 	readBreakConstr();
@@ -749,304 +775,322 @@ void TinyParser::readSE2(){
 	}
 }
 
+FILE* TinyParser::openXml(std::string fileName){
+	// XML files can be large: write them in big chunks
+	FILE* fp = fopen(fileName.c_str(), "w");
+	if (fp == NULL) {
+		XMLCheckResult(tinyxml2::XML_ERROR_FILE_COULD_NOT_BE_OPENED);
+		return NULL;
+	}
+	setvbuf(fp, NULL, _IOFBF, 1 << 20);
+	return fp;
+}
+
 void TinyParser::serializeInstance(std::string fileName){
-	// Translate data structures into XML
+	// Translate data structures into XML, elements are written as soon as they are complete
+	FILE* fp = openXml(fileName);
+	if (fp == NULL) { return; }
+	tinyxml2::XMLPrinter printer(fp);
+	printer.PushDeclaration(XML_DECLARATION);
 
-	// Create a new declaration for the document
-	doc->InsertFirstChild(doc->NewDeclaration());
-	
-	// Create root node and append it to document
-	tinyxml2::XMLElement* root = doc->NewElement("Instance");
-	doc->InsertEndChild(root);
+	// Create root node
+	printer.OpenElement("Instance");
 
 	// Add meta data tags
-	tinyxml2::XMLElement* meta = doc->NewElement("MetaData");
-	addChildNode(meta, "InstanceName", Instance::get()->getInstanceName());
-	addChildNode(meta, "DataType", DataTypeToStr[Instance::get()->getDataType()]);
-	addChildNode(meta, "Contributor", Instance::get()->getContributor());
+	printer.OpenElement("MetaData");
+	addChildNode(printer, "InstanceName", Instance::get()->getInstanceName());
+	addChildNode(printer, "DataType", DataTypeToStr[Instance::get()->getDataType()]);
+	addChildNode(printer, "Contributor", Instance::get()->getContributor());
 	int day = std::get<0>(Instance::get()->getDate());
 	int month = std::get<1>(Instance::get()->getDate());
 	int year = std::get<2>(Instance::get()->getDate());
 	if (year != -1) { 
-		tinyxml2::XMLElement* date = doc->NewElement("Date");
-		date->SetAttribute("year", year);
-		if (month != -1) { date->SetAttribute("month", month); }
-		if (day != -1) { date->SetAttribute("day", day); }
-		meta->InsertEndChild(date);
+		printer.OpenElement("Date");
+		printer.PushAttribute("year", year);
+		if (month != -1) { printer.PushAttribute("month", month); }
+		if (day != -1) { printer.PushAttribute("day", day); }
+		printer.CloseElement();
 	}
-	addChildNode(meta, "Country", Instance::get()->getCountry());
-	addChildNode(meta, "Description", Instance::get()->getDescription());
-	addChildNode(meta, "Remarks", Instance::get()->getRemarks());
-	root->InsertEndChild(meta);
+	addChildNode(printer, "Country", Instance::get()->getCountry());
+	addChildNode(printer, "Description", Instance::get()->getDescription());
+	addChildNode(printer, "Remarks", Instance::get()->getRemarks());
+	printer.CloseElement();
 
 	// Add structure tags
-	tinyxml2::XMLElement* struc = doc->NewElement("Structure");
+	printer.OpenElement("Structure");
 
 	// Add a format tag for each league
 	for (auto i:Instance::get()->getLeagues()) {
-		tinyxml2::XMLElement* form = doc->NewElement("Format");
-		form->SetAttribute("leagueIds", std::to_string(i.second->getId()).c_str());
-		addChildNode(form, "numberRoundRobin", std::to_string(i.second->getNrRound()));
-		addChildNode(form, "compactness", CompactnessToStr[i.second->getComp()]);
-		addChildNode(form, "gameMode", GameModeToStr[i.second->getMode()]);
-		struc->InsertEndChild(form);
+		printer.OpenElement("Format");
+		printer.PushAttribute("leagueIds", i.second->getId());
+		addChildNode(printer, "numberRoundRobin", std::to_string(i.second->getNrRound()));
+		addChildNode(printer, "compactness", CompactnessToStr[i.second->getComp()]);
+		addChildNode(printer, "gameMode", GameModeToStr[i.second->getMode()]);
+		printer.CloseElement();
 	}
-	root->InsertEndChild(struc);
 
 	// Check for additional games
-	serializeGames();
+	serializeGames(printer);
+	printer.CloseElement();
 
 	// Add objective function tag
-	tinyxml2::XMLElement* obj = doc->NewElement("ObjectiveFunction");
-	addChildNode(obj, "Objective", ObjModeToStr[Instance::get()->getObjective()]);
-	root->InsertEndChild(obj);
+	printer.OpenElement("ObjectiveFunction");
+	addChildNode(printer, "Objective", ObjModeToStr[Instance::get()->getObjective()]);
+	printer.CloseElement();
 
-	// Add data tags
-	tinyxml2::XMLElement* data = doc->NewElement("Data");
+	// Add data tags, attributes in alphabetical order as for any other element
+	printer.OpenElement("Data");
 
 	// Pairwise distances
-	tinyxml2::XMLElement* distances = doc->NewElement("Distances");
-	for (auto i:Instance::get()->serializeDistances()) {
-		distances->InsertEndChild(serialize(i));	
+	printer.OpenElement("Distances");
+	for (const auto& d:Instance::get()->getDistances()) {
+		printer.OpenElement("distance");
+		printer.PushAttribute("dist", d.second);
+		printer.PushAttribute("team1", d.first.first->getId());
+		printer.PushAttribute("team2", d.first.second->getId());
+		printer.CloseElement();
 	}
-	data->InsertEndChild(distances);
+	printer.CloseElement();
 
 	// COE Weights
-	tinyxml2::XMLElement* weights = doc->NewElement("COEWeights");
-	for (auto i:Instance::get()->serializeCOEWeights()) {
-		weights->InsertEndChild(serialize(i));	
+	printer.OpenElement("COEWeights");
+	for (const auto& w:Instance::get()->getCOEWeights()) {
+		printer.OpenElement("COEWeight");
+		printer.PushAttribute("team1", w.first.first->getId());
+		printer.PushAttribute("team2", w.first.second->getId());
+		printer.PushAttribute("weight", w.second);
+		printer.CloseElement();
 	}
-	data->InsertEndChild(weights);
-	
+	printer.CloseElement();
 
 	// Costs
-	tinyxml2::XMLElement* costs = doc->NewElement("Costs");
-	for (auto i:Instance::get()->serializeCosts()) {
-		costs->InsertEndChild(serialize(i));	
+	printer.OpenElement("Costs");
+	for (const auto& c:Instance::get()->getCosts()) {
+		printer.OpenElement("cost");
+		printer.PushAttribute("cost", c.second);
+		printer.PushAttribute("slot", std::get<2>(c.first)->getId());
+		printer.PushAttribute("team1", std::get<0>(c.first)->getId());
+		printer.PushAttribute("team2", std::get<1>(c.first)->getId());
+		printer.CloseElement();
 	}
-	data->InsertEndChild(costs);
-	
-	root->InsertEndChild(data);
-
+	printer.CloseElement();
 
+	printer.CloseElement();
 
 	// Add resources tag
-	tinyxml2::XMLElement* res = doc->NewElement("Resources");
+	printer.OpenElement("Resources");
 
-	tinyxml2::XMLElement* leagueGroups = doc->NewElement("LeagueGroups");
+	printer.OpenElement("LeagueGroups");
 	for (auto i:Instance::get()->getLeagueGroups()) {
-		leagueGroups->InsertEndChild(serialize(i.second->serialize()));	
+		serialize(printer, i.second->serialize());
 	}
-	res->InsertEndChild(leagueGroups);
+	printer.CloseElement();
 
-	tinyxml2::XMLElement* leagues = doc->NewElement("Leagues");
+	printer.OpenElement("Leagues");
 	for (auto i:Instance::get()->getLeagues()) {
-		leagues->InsertEndChild(serialize(i.second->serialize()));	
+		serialize(printer, i.second->serialize());
 	}	
-	res->InsertEndChild(leagues);
+	printer.CloseElement();
 
-	tinyxml2::XMLElement* teamGroups = doc->NewElement("TeamGroups");
+	printer.OpenElement("TeamGroups");
 	for (auto i:Instance::get()->getTeamGroups()) {
-		teamGroups->InsertEndChild(serialize(i.second->serialize()));	
+		serialize(printer, i.second->serialize());
 	}	
-	res->InsertEndChild(teamGroups);
+	printer.CloseElement();
 
-	tinyxml2::XMLElement* teams = doc->NewElement("Teams");
+	printer.OpenElement("Teams");
 	for (auto i:Instance::get()->getTeams()) {
-		teams->InsertEndChild(serialize(i.second->serialize()));	
+		serialize(printer, i.second->serialize());
 	}	
-	res->InsertEndChild(teams);
+	printer.CloseElement();
 
-	tinyxml2::XMLElement* slotGroups = doc->NewElement("SlotGroups");
+	printer.OpenElement("SlotGroups");
 	for (auto i:Instance::get()->getSlotGroups()) {
-		slotGroups->InsertEndChild(serialize(i.second->serialize()));	
+		serialize(printer, i.second->serialize());
 	}		
-	res->InsertEndChild(slotGroups);
+	printer.CloseElement();
 
-	tinyxml2::XMLElement* slots = doc->NewElement("Slots");
+	printer.OpenElement("Slots");
 	for (auto i:Instance::get()->getSlots()) {
-		slots->InsertEndChild(serialize(i.second->serialize()));	
+		serialize(printer, i.second->serialize());
 	}
-	res->InsertEndChild(slots);
-
-	root->InsertEndChild(res);
-
-
-
-	// Add constraints tag
-	tinyxml2::XMLElement* cons = doc->NewElement("Constraints");
-	cons->InsertEndChild(doc->NewElement("BasicConstraints"));
-	cons->InsertEndChild(doc->NewElement("CapacityConstraints"));
-	cons->InsertEndChild(doc->NewElement("GameConstraints"));
-	cons->InsertEndChild(doc->NewElement("BreakConstraints"));
-	cons->InsertEndChild(doc->NewElement("FairnessConstraints"));
-	cons->InsertEndChild(doc->NewElement("SeparationConstraints"));
-
-	for (auto c : Instance::get()->getCnstrs()) {
-		// Query the class constraint
-		AttrMap attrs = c->serialize();
-		tinyxml2::XMLElement* el = cons->FirstChildElement(attrs.at("ClassType").c_str());
-		el->InsertEndChild(serialize(attrs));
+	printer.CloseElement();
+
+	printer.CloseElement();
+
+	// Add constraints tag: constraints are grouped per class, in the order of the constraint list
+	const std::vector<std::pair<std::string, const char*>> classes = {
+		{"BA", "BasicConstraints"},
+		{"CA", "CapacityConstraints"},
+		{"GA", "GameConstraints"},
+		{"BR", "BreakConstraints"},
+		{"FA", "FairnessConstraints"},
+		{"SE", "SeparationConstraints"}
+	};
+	ConstraintList cnstrs = Instance::get()->getCnstrs();
+	printer.OpenElement("Constraints");
+	for (auto cl : classes) {
+		printer.OpenElement(cl.second);
+		for (auto c : cnstrs) {
+			if (c->getName().compare(0, 2, cl.first) == 0) {
+				serialize(printer, c->serialize());
+			}
+		}
+		printer.CloseElement();
 	}
-	root->InsertEndChild(cons);
+	printer.CloseElement();
 
-	// Save file
-	tinyxml2::XMLError err = doc->SaveFile(fileName.c_str());
-	XMLCheckResult(err);	
+	// Close root node and file
+	printer.CloseElement();
+	fclose(fp);
 	return;
 }
 
 void TinyParser::serializeSolution(std::string fileName){
-	// Translate data structures into XML
-	
-	// Create a new declaration for the document
-	doc->InsertFirstChild(doc->NewDeclaration());
+	// Translate data structures into XML, elements are written as soon as they are complete
+	FILE* fp = openXml(fileName);
+	if (fp == NULL) { return; }
+	tinyxml2::XMLPrinter printer(fp);
+	printer.PushDeclaration(XML_DECLARATION);
 	
-	// Create root node and append it to document
-	tinyxml2::XMLElement* root = doc->NewElement("Solution");
-	doc->InsertEndChild(root);
+	// Create root node
+	printer.OpenElement("Solution");
 
 	// Add meta data tags
-	tinyxml2::XMLElement* meta = doc->NewElement("MetaData");
-	addChildNode(meta, "SolutionName", Instance::get()->getSolutionName());
-	addChildNode(meta, "InstanceName", Instance::get()->getInstanceName());
-	addChildNode(meta, "Contributor", Instance::get()->getContributor());
+	printer.OpenElement("MetaData");
+	addChildNode(printer, "SolutionName", Instance::get()->getSolutionName());
+	addChildNode(printer, "InstanceName", Instance::get()->getInstanceName());
+	addChildNode(printer, "Contributor", Instance::get()->getContributor());
 	int day = std::get<0>(Instance::get()->getDate());
 	int month = std::get<1>(Instance::get()->getDate());
 	int year = std::get<2>(Instance::get()->getDate());
 	if (year != -1) { 
-		tinyxml2::XMLElement* date = doc->NewElement("Date");
-		date->SetAttribute("year", year);
-		if (month != -1) { date->SetAttribute("month", month); }
-		if (day != -1) { date->SetAttribute("day", day); }
-		meta->InsertEndChild(date);
+		printer.OpenElement("Date");
+		printer.PushAttribute("year", year);
+		if (month != -1) { printer.PushAttribute("month", month); }
+		if (day != -1) { printer.PushAttribute("day", day); }
+		printer.CloseElement();
 	}
-	addChildNode(meta, "SolutionMethod",  SolutionMethodToStr[Instance::get()->getSolutionMethod()]);
+	addChildNode(printer, "SolutionMethod",  SolutionMethodToStr[Instance::get()->getSolutionMethod()]);
 
 	// Add objective value
-	tinyxml2::XMLElement* obj = doc->NewElement("ObjectiveValue");
-	obj->SetAttribute("infeasibility", Instance::get()->getObjectiveValue().first);
-	obj->SetAttribute("objective", Instance::get()->getObjectiveValue().second);
-	meta->InsertEndChild(obj);
-
-	addChildNode(meta, "Remarks", Instance::get()->getRemarks());
+	printer.OpenElement("ObjectiveValue");
+	printer.PushAttribute("infeasibility", Instance::get()->getObjectiveValue().first);
+	printer.PushAttribute("objective", Instance::get()->getObjectiveValue().second);
+	printer.CloseElement();
 
-	// Append meta data alement to document tree
-	root->InsertEndChild(meta);
+	addChildNode(printer, "Remarks", Instance::get()->getRemarks());
+	printer.CloseElement();
 
 	// Save all scheduled games
-	tinyxml2::XMLElement* games = doc->NewElement("Games");
+	printer.OpenElement("Games");
 	for (auto m:Instance::get()->getMeetings()) {
 		if (m->getAssignedSlot() != NULL) {
-			tinyxml2::XMLElement* game = doc->NewElement("ScheduledMatch");
-			game->SetAttribute("home", m->getFirstTeam()->getId());
-			game->SetAttribute("away", m->getSecondTeam()->getId());
-			game->SetAttribute("slot", m->getAssignedSlot()->getId());
-			games->InsertEndChild(game);
+			printer.OpenElement("ScheduledMatch");
+			printer.PushAttribute("home", m->getFirstTeam()->getId());
+			printer.PushAttribute("away", m->getSecondTeam()->getId());
+			printer.PushAttribute("slot", m->getAssignedSlot()->getId());
+			printer.CloseElement();
 		}
 	}
-	root->InsertEndChild(games);
+	printer.CloseElement();
 
-	// Save file
-	tinyxml2::XMLError err = doc->SaveFile(fileName.c_str());
-	XMLCheckResult(err);	
+	// Close root node and file
+	printer.CloseElement();
+	fclose(fp);
 	return;
 }
 void TinyParser::serializeBound(std::string fileName){
-	// Translate data structures into XML
+	// Translate data structures into XML, elements are written as soon as they are complete
+	FILE* fp = openXml(fileName);
+	if (fp == NULL) { return; }
+	tinyxml2::XMLPrinter printer(fp);
+	printer.PushDeclaration(XML_DECLARATION);
 	
-	// Create a new declaration for the document
-	doc->InsertFirstChild(doc->NewDeclaration());
-	
-	// Create root node and append it to document
-	tinyxml2::XMLElement* root = doc->NewElement("Bound");
-	doc->InsertEndChild(root);
+	// Create root node
+	printer.OpenElement("Bound");
 
 	// Add meta data tags
-	tinyxml2::XMLElement* meta = doc->NewElement("MetaData");
-	addChildNode(meta, "InstanceName", Instance::get()->getInstanceName());
-	addChildNode(meta, "Contributor", Instance::get()->getContributor());
+	printer.OpenElement("MetaData");
+	addChildNode(printer, "InstanceName", Instance::get()->getInstanceName());
+	addChildNode(printer, "Contributor", Instance::get()->getContributor());
 	int day = std::get<0>(Instance::get()->getDate());
 	int month = std::get<1>(Instance::get()->getDate());
 	int year = std::get<2>(Instance::get()->getDate());
 	if (year != -1) { 
-		tinyxml2::XMLElement* date = doc->NewElement("Date");
-		date->SetAttribute("year", year);
-		if (month != -1) { date->SetAttribute("month", month); }
-		if (day != -1) { date->SetAttribute("day", day); }
-		meta->InsertEndChild(date);
+		printer.OpenElement("Date");
+		printer.PushAttribute("year", year);
+		if (month != -1) { printer.PushAttribute("month", month); }
+		if (day != -1) { printer.PushAttribute("day", day); }
+		printer.CloseElement();
 	}
 
 	// Add objective value
-	tinyxml2::XMLElement* bound = doc->NewElement("LowerBound");
-	addChildNode(bound, "Infeasibility", std::to_string(Instance::get()->getLowerBound().first));
-	addChildNode(bound, "Objective", std::to_string(Instance::get()->getLowerBound().second));
-	meta->InsertEndChild(bound);
-
-	addChildNode(meta, "Remarks", Instance::get()->getRemarks());
+	printer.OpenElement("LowerBound");
+	addChildNode(printer, "Infeasibility", std::to_string(Instance::get()->getLowerBound().first));
+	addChildNode(printer, "Objective", std::to_string(Instance::get()->getLowerBound().second));
+	printer.CloseElement();
 
-	// Append meta data alement to document tree
-	root->InsertEndChild(meta);
+	addChildNode(printer, "Remarks", Instance::get()->getRemarks());
+	printer.CloseElement();
 
-	// Save file
-	tinyxml2::XMLError err = doc->SaveFile(fileName.c_str());
-	XMLCheckResult(err);	
+	// Close root node and file
+	printer.CloseElement();
+	fclose(fp);
 	return;
 }
 
-tinyxml2::XMLElement* TinyParser::serialize(AttrMap attrs){
-	// Create element to be appended
-	tinyxml2::XMLElement* el = doc->NewElement(attrs.at("Type").c_str());
-	for (AttrMap::iterator it = attrs.begin();  it != attrs.end(); ++it){
+void TinyParser::serialize(tinyxml2::XMLPrinter& printer, const AttrMap& attrs){
+	// Write an element with all attributes, the printer keeps a pointer to the name until closing
+	printer.OpenElement(attrs.at("Type").c_str());
+	for (AttrMap::const_iterator it = attrs.begin();  it != attrs.end(); ++it){
 		if (it->first == "ClassType" || it->first == "Type") { continue; }
-		el->SetAttribute(it->first.c_str(), it->second.c_str());
+		printer.PushAttribute(it->first.c_str(), it->second.c_str());
 	}	
-	return el;
+	printer.CloseElement();
 }
-void TinyParser::serializeGames(){
+void TinyParser::serializeGames(tinyxml2::XMLPrinter& printer){
 	// A meeting should be added to the additinal games block if:
 		// The two teams play in different leagues
 		// The two teams meet each other more than prescribed in kRR of league, in
 		// this case we add by preference games with noHome = false
-	TeamMap teams = Instance::get()->getTeams();
-	tinyxml2::XMLElement* struc = doc->RootElement()->FirstChildElement("Structure");
-	tinyxml2::XMLElement* addGames = doc->NewElement("AdditionalGames");
-
-	for (TeamMapIt t1 = teams.begin(); t1 != teams.end(); ++t1) {
-		for (TeamMapIt t2 = std::next(t1); t2 != teams.end(); ++t2) {
-				// Save file
-			MeetingList meetings;
-			for(auto m:Instance::get()->getMeetings()){
-				if ((t1->second == m->getFirstTeam() && t2->second == m->getSecondTeam()) || 
-				    (t2->second == m->getFirstTeam() && t1->second == m->getSecondTeam())) {
-				    	meetings.push_back(m);
-				}
-			}	
-			if (t1->second->getLeague() != t2->second->getLeague()) {
-				for (auto m : meetings) {
-					tinyxml2::XMLElement* game = doc->NewElement("game");
-					game->SetAttribute("team1", m->getFirstTeam()->getId());
-					game->SetAttribute("team2", m->getSecondTeam()->getId());
-					game->SetAttribute("noHome", m->getNoHome());
-					addGames->InsertEndChild(game);
-				}
-			} else if ((int) meetings.size() > t1->second->getLeague()->getNrRound()) {
-				// By preference: add meetings with noHome = true	
-				// Sort meeting list so that these meetings are in front
-				meetings.sort(compMeetingNoHome);
-				int toAdd = meetings.size() - t1->second->getLeague()->getNrRound();
-				int added = 0;
-				for (std::list<Meeting*>::reverse_iterator it = meetings.rbegin(); it != meetings.rend(); ++it) {
-					if (added++ == toAdd) { break; }
-					tinyxml2::XMLElement* game = doc->NewElement("game");
-					game->SetAttribute("team1", (*it)->getFirstTeam()->getId());
-					game->SetAttribute("team2", (*it)->getSecondTeam()->getId());
-					game->SetAttribute("noHome", (*it)->getNoHome());
-					addGames->InsertEndChild(game);
-				}
+	// The meetings are grouped per pair of teams in one pass, pairs in increasing order of the team ids
+	std::map<std::pair<int, int>, MeetingList> pairMeetings;
+	for (auto m:Instance::get()->getMeetings()) {
+		const int id1 = m->getFirstTeam()->getId();
+		const int id2 = m->getSecondTeam()->getId();
+		pairMeetings[std::make_pair(std::min(id1, id2), std::max(id1, id2))].push_back(m);
+	}
+	printer.OpenElement("AdditionalGames");
+
+	for (auto& p : pairMeetings) {
+		MeetingList& meetings = p.second;
+		Team* t1 = meetings.front()->getFirstTeam();
+		Team* t2 = meetings.front()->getSecondTeam();
+		if (t1->getLeague() != t2->getLeague()) {
+			for (auto m : meetings) {
+				printer.OpenElement("game");
+				printer.PushAttribute("team1", m->getFirstTeam()->getId());
+				printer.PushAttribute("team2", m->getSecondTeam()->getId());
+				printer.PushAttribute("noHome", m->getNoHome());
+				printer.CloseElement();
+			}
+		} else if ((int) meetings.size() > t1->getLeague()->getNrRound()) {
+			// By preference: add meetings with noHome = true	
+			// Sort meeting list so that these meetings are in front
+			meetings.sort(compMeetingNoHome);
+			int toAdd = meetings.size() - t1->getLeague()->getNrRound();
+			int added = 0;
+			for (std::list<Meeting*>::reverse_iterator it = meetings.rbegin(); it != meetings.rend(); ++it) {
+				if (added++ == toAdd) { break; }
+				printer.OpenElement("game");
+				printer.PushAttribute("team1", (*it)->getFirstTeam()->getId());
+				printer.PushAttribute("team2", (*it)->getSecondTeam()->getId());
+				printer.PushAttribute("noHome", (*it)->getNoHome());
+				printer.CloseElement();
 			}
-		}	
+		}
 	}
 
-	struc->InsertEndChild(addGames);
+	printer.CloseElement();
 }
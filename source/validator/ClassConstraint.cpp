@@ -5,6 +5,50 @@
 
 #define IN Instance::get()
 
+thread_local int Constraint::deviation = 0;
+
+int Constraint::getDeviation() const{
+	return IN->getDeviation(this);
+}
+
+// Slot of every game of a team in increasing order, and whether the game results in a { regular,
+// generalized } break with home mode mode. Computed from the meetings, for schedules that cannot be packed.
+static std::vector<std::pair<int, bool>> breakPattern(Team* t, const BreakMode bMode, const HomeMode mode){
+	MeetingList meetings = IN->getMeetingsTeam({t}, HA);
+	meetings.sort(compMeetingScheduledSlot);
+	std::vector<std::pair<int, bool>> pattern;
+	Meeting* prev = NULL;
+	for (auto m : meetings) {
+		const bool home = (m->getFirstTeam() == t);
+		const bool isBreak = prev != NULL && (prev->getFirstTeam() == t) == home && (mode == HA || home == (mode == H))
+			&& (bMode == GENERALIZED || prev->getAssignedSlot()->getId() + 1 == m->getAssignedSlot()->getId());
+		pattern.push_back(std::make_pair(m->getAssignedSlot()->getId(), isBreak));
+		prev = m;
+	}
+	return pattern;
+}
+
+// Bit row of the slots in the ranges, for evaluation on the bitboards of the packed schedule
+static SlotMask rangeMask(const PackedSchedule& ps, const std::vector<std::pair<int, int>>& ranges){
+	SlotMask mask(ps.getNrWords(), 0);
+	for (auto r : ranges) {
+		for (int s = r.first; s <= r.second; ++s) { mask[s/64] |= (uint64_t) 1 << (s%64); }
+	}
+	return mask;
+}
+
+// Games of team t1 against team t2 in the slots of the mask on the bitboards, at home (H), away (A), or both (HA)
+template <HomeMode mode>
+static int pairGames(const PackedSchedule& ps, const int t1, const int t2, const SlotMask& mask){
+	const uint64_t* home = ps.getPairRow(t1, t2);
+	const uint64_t* away = ps.getPairRow(t2, t1);
+	int nr = 0;
+	for (int w = 0; w < ps.getNrWords(); ++w) {
+		nr += __builtin_popcountll(((mode != A ? home[w] : 0) | (mode != H ? away[w] : 0)) & mask[w]);
+	}
+	return nr;
+}
+
 template<typename T>
 std::string printSet(std::set<T*> set){
 	// Requires a set of objects that have getId() function.
@@ -49,11 +93,11 @@ ObjCost BA1::checkConstr(){
 	ObjCost c = std::make_pair(0,0);
 	for(auto m : IN->getMeetings()){
 		if (m->getAssignedSlot() == NULL) {
-			(type == HARD) ? c.first += penalty : c.second += penalty;
+			addDeviation(c, 1);
 			std::stringstream msg1;
 			msg1 << "Unscheduled meeting between team " << m->getFirstTeam() << " (" << m->getFirstTeam()->getName() << ")" << " and " << m->getSecondTeam() << " (" << m->getSecondTeam()->getName() << ")" << ".";	
 			if (penalty > 0) {
-				std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+				Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 			}
 		}	
 	}
@@ -79,10 +123,10 @@ ObjCost BA2::checkConstr(){
 			MeetingList meetings = IN->getMeetingsTeamSlot({t.second}, {s.second}, HA);	
 			deviation = meetings.size() - 1;
 			if (deviation > 0) {
-				(type == HARD) ? c.first += penalty*deviation : c.second += penalty*deviation;
+				addDeviation(c, deviation);
 				std::stringstream msg1;
 				msg1 << "Team " << t.second << " plays " << deviation + 1 << " games in slot " << s.second;
-				std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+				Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 			}	
 		}
 	}
@@ -178,18 +222,19 @@ ObjCost CA1::checkConstr(){
 	 * in S less than k or more than k max.
 	 */
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const int slotsId = IN->internSlots(slots, slotGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(slotsId);
 	for (auto t : allTeams) {
-		int nrMeetings = IN->getMeetingsTeamSlot({t}, allSlots, mode).size();
+		int nrMeetings = IN->nrGames(t, slotsId, mode);
 		int p = std::max(0, nrMeetings-max) + std::max(0, min-nrMeetings);
 		if (p != 0) {
-			(type == HARD) ? c.first += p*penalty : c.second += p*penalty;
+			addDeviation(c, p);
 			std::stringstream msg1;
 			msg1 << "Team " << std::setw(3) << t->getId() << " (" << t->getName() << ") has " << std::setw(3) << nrMeetings
 			       	<< " " << std::setw(2) << HomeModeToStr[mode] << "-games in S. Allowed range is [" << min << "," << max <<"].";
-			std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-			std::cout << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
+			Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+			Instance::report() << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
 		}
 	}
 	return c;
@@ -354,38 +399,47 @@ ObjCost CA2::checkConstr(){
 	 * T 2 in S less than k min or more than k max .
 	 */
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams1 = IN->collectTeams(teams1, teamGroups1);
-	TeamSet allTeams2 = IN->collectTeams(teams2, teamGroups2);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams1 = IN->internTeams(teams1, teamGroups1);
+	const TeamSet& allTeams2 = IN->internTeams(teams2, teamGroups2);
+	const int slotsId = IN->internSlots(slots, slotGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(slotsId);
+	const int* counts = IN->getBatchCounts(this);
 	assert(mode2 == EVERY || mode2 == GLOBAL);
 	if (mode2 == GLOBAL) {
+		int k = 0;
 		for (auto t : allTeams1) {
-			int nrMeetings = IN->getMeetingsTeamTeamSlot({t}, allTeams2, allSlots, mode1).size();
+			int nrMeetings = 0;
+			if (counts) { nrMeetings = counts[k++]; }
+			else { nrMeetings = IN->getMeetingsTeamTeamSlot({t}, allTeams2, allSlots, mode1).size(); }
 			int p = std::max(0, nrMeetings-max) + std::max(0, min-nrMeetings);
 			if (p != 0) {
-				(type == HARD) ? c.first += p*penalty : c.second += p*penalty;
+				addDeviation(c, p);
 				std::stringstream msg1;
 				msg1 << "Team " << std::setw(3) << t->getId() << " (" << t->getName() << ") has " << std::setw(3) << nrMeetings
 						<< " " << std::setw(2) << HomeModeToStr[mode1] << "-games against teams in T2. Allowed range is [" << min << "," << max <<"].";
-				std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-				std::cout << std::setw(20) << "" <<  "T2: " << printSet(allTeams2) << std::endl;
-				std::cout << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
+				Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+				Instance::report() << std::setw(20) << "" <<  "T2: " << printSet(allTeams2) << std::endl;
+				Instance::report() << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
 			}
 		}
 	} else { // Every
+		int k = 0;
 		for (auto t1 : allTeams1) {
 			for(auto t2 : allTeams2) {
+				const int pairCount = counts ? counts[k++] : 0;
 				if (t1 == t2) { continue; }
-				int nrMeetings = IN->getMeetingsTeamTeamSlot({t1}, {t2}, allSlots, mode1).size();
+				int nrMeetings = 0;
+				if (counts) { nrMeetings = pairCount; }
+				else { nrMeetings = IN->getMeetingsTeamTeamSlot({t1}, {t2}, allSlots, mode1).size(); }
 				int p = std::max(0, nrMeetings-max) + std::max(0, min-nrMeetings);
 				if (p != 0) {
-					(type == HARD) ? c.first += p*penalty : c.second += p*penalty;
+					addDeviation(c, p);
 					std::stringstream msg1;
 					msg1 << "Team " << std::setw(3) << t1->getId() << " has " << std::setw(3) << nrMeetings
 						<< " " << std::setw(2) << HomeModeToStr[mode1] << "-games against team " << t2 << ". Allowed range is [" << min << "," << max <<"].";
 
-					std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-					std::cout << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
+					Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+					Instance::report() << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
 				}
 			}
 		}
@@ -413,7 +467,7 @@ CA3::CA3 (CType c, int p) : Constraint(c,p, "CA3"){
 				continue;	
 			}
 			if (CA3* conCA3 = dynamic_cast<CA3*>(con)) {
-				std::cout << "CA3" << std::endl;	
+				Instance::report() << "CA3" << std::endl;	
 				if (conCA3->mode1 == H) {
 					homeAlreadyPresent = true;	
 				} else {
@@ -515,28 +569,46 @@ ObjCost CA3::checkConstr(){
 	 **/
 
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams1 = IN->collectTeams(teams1, teamGroups1);
-	TeamSet allTeams2 = IN->collectTeams(teams2, teamGroups2);
+	const TeamSet& allTeams1 = IN->internTeams(teams1, teamGroups1);
+	const TeamSet& allTeams2 = IN->internTeams(teams2, teamGroups2);
 	if (mode2 == SLOTS) { // Sequence of slots
-		SlotMap slots = IN->getSlots();
-		assert(IN->getSlots().size() >= intp);
+		// Slots in increasing id
+		std::vector<Slot*> slots;
+		for (auto s : IN->getSlots()) { slots.push_back(s.second); }
+		assert(slots.size() >= intp);
+
+		// On the packed schedule, slot ids equal the positions in slots, and the games against teams in T2 in a
+		// window are a subtraction of prefix sums
+		const PackedSchedule& ps = IN->getPackedSchedule();
+		std::vector<char> isTeam2(ps.getNrTeams(), 0);
+		for (auto t2 : allTeams2) {
+			if (ps.isValid()) { isTeam2[t2->getId()] = 1; }
+		}
+		std::vector<int> before(slots.size() + 1, 0);
 		for (auto t : allTeams1) {
-			for (SlotMapIt it1 = slots.begin(); it1 != std::prev(slots.end(), intp - 1); ++it1) {
-				SlotSet period = {it1->second};
-				SlotMapIt begin2 = std::next(it1);
-				SlotMapIt end2 = std::next(it1, intp);
-				for (SlotMapIt it2 = begin2; it2 != end2; ++it2) {
-					period.insert(it2->second);
+			if (ps.isValid()) {
+				for (int s = 0; s < (int) slots.size(); ++s) {
+					const int o = ps.getOpponent(t->getId(), s);
+					const bool home = ps.isHome(t->getId(), s);
+					before[s+1] = before[s] + (o != -1 && isTeam2[o] && (mode1 == HA || (mode1 == H) == home));
+				}
+			}
+			for (int i = 0; i + intp <= (int) slots.size(); ++i) {
+				int nrMeetings;
+				if (ps.isValid()) {
+					nrMeetings = before[i + intp] - before[i];
+				} else {
+					nrMeetings = IN->getMeetingsTeamTeamSlot({t}, allTeams2, SlotSet(slots.begin() + i, slots.begin() + i + intp), mode1).size();
 				}
-				int nrMeetings = IN->getMeetingsTeamTeamSlot({t}, allTeams2, period, mode1).size();
 				int p = std::max(0, nrMeetings-max) + std::max(0, min-nrMeetings);
 				if (p != 0) {
-					(type == HARD) ? c.first += p*penalty : c.second += p*penalty;
+					SlotSet period(slots.begin() + i, slots.begin() + i + intp);
+					addDeviation(c, p);
 					std::stringstream msg1;
 					msg1 << "Team " << std::setw(3) << t->getId() << " has " << std::setw(3) << nrMeetings
 							<< " " << std::setw(2) << HomeModeToStr[mode1] << "-games in " << std::setw(2) << intp << " slots. Allowed range is [" << min << "," << max <<"].";
-					std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-					std::cout << std::setw(20) << "" <<  "Slots: " << printSet(period) << std::endl;
+					Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+					Instance::report() << std::setw(20) << "" <<  "Slots: " << printSet(period) << std::endl;
 				}
 			}
 		}
@@ -567,11 +639,11 @@ ObjCost CA3::checkConstr(){
 				}
 				int dev = std::max(0, cntr-max) + std::max(0, min-cntr);
 				if (dev > 0) {
-					(type == HARD) ? c.first += dev*penalty : c.second += dev*penalty;
+					addDeviation(c, dev);
 					std::stringstream msg;
 					msg << "Team " << std::setw(3) << t->getId() << " has " << std::setw(3) << cntr
 						<< " consecutive " << std::setw(2) << HomeModeToStr[mode1] << "-games. Series starts in slot " << (*it1)->getAssignedSlot() << ". Allowed range is [" << min << "," << max <<"].";
-					std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+					Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 				}
 			}
 		}
@@ -693,32 +765,41 @@ ObjCost CA4::checkConstr(){
 
 	ObjCost c = std::make_pair(0,0);
 
-	TeamSet allTeams1 = IN->collectTeams(teams1, teamGroups1);
-	TeamSet allTeams2 = IN->collectTeams(teams2, teamGroups2);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams1 = IN->internTeams(teams1, teamGroups1);
+	const TeamSet& allTeams2 = IN->internTeams(teams2, teamGroups2);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
+	const int* counts = IN->getBatchCounts(this);
 	if (mode2 == GLOBAL) {
-		int nrMeetings = IN->getMeetingsTeamTeamSlot(allTeams1, allTeams2, allSlots, mode1).size();
+		int nrMeetings = 0;
+		if (counts) {
+			for (int k = 0; k < (int) allSlots.size(); ++k) { nrMeetings += counts[k]; }
+		} else {
+			nrMeetings = IN->getMeetingsTeamTeamSlot(allTeams1, allTeams2, allSlots, mode1).size();
+		}
 		int deviation = std::max(nrMeetings - max, min - nrMeetings);
 		if (deviation > 0) {
-			(type == HARD) ? c.first += penalty*deviation : c.second += penalty*deviation;
+			addDeviation(c, deviation);
 			std::stringstream msg1;
 			msg1 << "There are " << nrMeetings << " teams playing " << HomeModeToStr[mode1] << " in given slots. Allowed range is [" << min << "," << max <<"].";
-			std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-			std::cout << std::setw(20) << "" <<  "Teams1: " << printSet(allTeams1) << std::endl;
-			std::cout << std::setw(20) << "" <<  "Teams2: " << printSet(allTeams2) << std::endl;
-			std::cout << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
+			Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+			Instance::report() << std::setw(20) << "" <<  "Teams1: " << printSet(allTeams1) << std::endl;
+			Instance::report() << std::setw(20) << "" <<  "Teams2: " << printSet(allTeams2) << std::endl;
+			Instance::report() << std::setw(20) << "" <<  "Slots: " << printSet(allSlots) << std::endl;
 		}
 	} else { // EVERY
+		int k = 0;
 		for (auto s : allSlots) {
-			int nrMeetings = IN->getMeetingsTeamTeamSlot(allTeams1, allTeams2, {s}, mode1).size();
+			int nrMeetings = 0;
+			if (counts) { nrMeetings = counts[k++]; }
+			else { nrMeetings = IN->getMeetingsTeamTeamSlot(allTeams1, allTeams2, {s}, mode1).size(); }
 			int deviation = std::max(nrMeetings - max, min - nrMeetings);
 			if (deviation > 0) {
-				(type == HARD) ? c.first += penalty*deviation : c.second += penalty*deviation;
+				addDeviation(c, deviation);
 				std::stringstream msg1;
 				msg1 << "There are " << nrMeetings << " teams playing " << HomeModeToStr[mode1] << " in slot " << s->getId() << ". Allowed range is [" << min << "," << max <<"].";
-				std::cout << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-				std::cout << std::setw(20) << "" <<  "Teams1: " << printSet(allTeams1) << std::endl;
-				std::cout << std::setw(20) << "" <<  "Teams2: " << printSet(allTeams2) << std::endl;
+				Instance::report() << std::setw(10) << name << std::setw(10) << "" << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+				Instance::report() << std::setw(20) << "" <<  "Teams1: " << printSet(allTeams1) << std::endl;
+				Instance::report() << std::setw(20) << "" <<  "Teams2: " << printSet(allTeams2) << std::endl;
 			}
 		}
 	}	
@@ -734,7 +815,7 @@ CA5::CA5 (CType c, int p, std::array<IdList, 2> teamIds1, int min, int max, std:
 	for (auto id : slotIds[1]){ slotGroups.insert(Instance::get()->getSlotGroup(id)); }
 }
 CA5::CA5 (CType c, int p) : Constraint(c,p, "CA5"){
-	std::cout << "CA5 random generator not yet initialized!" << std::endl;
+	Instance::report() << "CA5 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap CA5::serialize(){
@@ -763,9 +844,9 @@ ObjCost CA5::checkConstr(){
 	 * of consecutive away games in S.
 	 **/
 
-	TeamSet allTeams1 = IN->collectTeams(teams1, teamGroups1);
-	TeamSet allTeams2 = IN->collectTeams(teams2, teamGroups2);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams1 = IN->internTeams(teams1, teamGroups1);
+	const TeamSet& allTeams2 = IN->internTeams(teams2, teamGroups2);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
 	
 	{ // Assumption: time group s contains a series of consecutive time slots
 		int prevS=-1;
@@ -805,7 +886,7 @@ ObjCost CA5::checkConstr(){
 					std::stringstream msg;
 					msg << "Team " << std::setw(3) << t->getId() << " plays " << std::setw(3) << cntr
 					<< " consecutive away-games against teams in T2. Series starts in slot " << (*it1)->getAssignedSlot() << ". Allowed range is [" << min << "," << max <<"].";
-					std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+					Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 				}
 			}
 		}
@@ -912,20 +993,31 @@ ObjCost GA1::checkConstr(){
 	 * than k min or more than k max .
 	 **/
 	ObjCost c = std::make_pair(0,0);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
-	MeetingList scheduledMeetings = IN->getMeetingsSlot(allSlots);
+	const int slotsId = IN->internSlots(slots, slotGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(slotsId);
+	const PackedSchedule& ps = IN->getPackedSchedule();
 	
 	int cntr = 0;
-	for(auto m : scheduledMeetings){
-		if (meetings.count(std::make_pair(m->getFirstTeam()->getId(), m->getSecondTeam()->getId()))) { cntr++; }
+	if (ps.hasBoards()) {
+		// Teams that are not in the league never play
+		const SlotMask mask = rangeMask(ps, IN->getSlotRanges(slotsId));
+		for (auto m : meetings) {
+			if (m.first < 0 || m.first >= ps.getNrTeams() || m.second < 0 || m.second >= ps.getNrTeams()) { continue; }
+			cntr += pairGames<H>(ps, m.first, m.second, mask);
+		}
+	} else {
+		MeetingList scheduledMeetings = IN->getMeetingsSlot(allSlots);
+		for(auto m : scheduledMeetings){
+			if (meetings.count(std::make_pair(m->getFirstTeam()->getId(), m->getSecondTeam()->getId()))) { cntr++; }
+		}
 	}
 	int dev = std::max(cntr - max, min - cntr);
 	if (dev > 0) {
 		std::stringstream msg;
 		msg << "Total of " << cntr << " scheduled games from " << printIntPairSet(meetings) <<". Allowed range [" << min << "," << max << "].";
-		(type == HARD) ? c.first += penalty*dev : c.second += penalty*dev;
-		std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-		std::cout << std::setw(10) << "Time slots: " << printSet(allSlots) << std::endl;
+		addDeviation(c, dev);
+		Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+		Instance::report() << std::setw(10) << "Time slots: " << printSet(allSlots) << std::endl;
 	}
 
 	return c;
@@ -951,7 +1043,7 @@ GA2::GA2(CType c, int p, std::array<IdList, 2> teamIds1, HomeMode mode1, std::ar
 	for (auto id : slotIds2[1]) { slotGroups2.insert(Instance::get()->getSlotGroup(id)); }
 }
 GA2::GA2 (CType c, int p) : Constraint(c,p, "GA2"){
-	std::cout << "GA2 random generator not yet initialized!" << std::endl;
+	Instance::report() << "GA2 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap GA2::serialize(){
@@ -988,13 +1080,13 @@ ObjCost GA2::checkConstr(){
 	assert(cMode == EQ || cMode == NEQ);
 	ObjCost c = std::make_pair(0,0);
 	
-	SlotSet allSlots1 = IN->collectSlots(slots1, slotGroups1);
-	SlotSet allSlots2 = IN->collectSlots(slots2, slotGroups2);
+	const SlotSet& allSlots1 = IN->getInternedSlots(IN->internSlots(slots1, slotGroups1));
+	const SlotSet& allSlots2 = IN->getInternedSlots(IN->internSlots(slots2, slotGroups2));
 
-	TeamSet allTeams1 = IN->collectTeams(teams1, teamGroups1);
-	TeamSet allTeams2 = IN->collectTeams(teams2, teamGroups2);
-	TeamSet allTeams3 = IN->collectTeams(teams3, teamGroups3);
-	TeamSet allTeams4 = IN->collectTeams(teams4, teamGroups4);
+	const TeamSet& allTeams1 = IN->internTeams(teams1, teamGroups1);
+	const TeamSet& allTeams2 = IN->internTeams(teams2, teamGroups2);
+	const TeamSet& allTeams3 = IN->internTeams(teams3, teamGroups3);
+	const TeamSet& allTeams4 = IN->internTeams(teams4, teamGroups4);
 
 	assert(cMode == EQ || cMode == NEQ);
 
@@ -1003,17 +1095,17 @@ ObjCost GA2::checkConstr(){
 		if (cMode == EQ && cntr == 0) {
 			std::stringstream msg;
 			msg << "A team from T1 plays a game against a team from T2 in slot " << printSet(allSlots1) << " but no team from T3 plays against a team from T4 in slot " << printSet(slots2);
-			(type == HARD) ? c.first += penalty : c.second += penalty;
-			std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+			addDeviation(c, 1);
+			Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 		} else if(cMode == NEQ && cntr > 0){
 			std::stringstream msg;
 			msg << "A team from T1 plays a game against a team from T2 in slot " << printSet(allSlots1) << " a team from T3 plays at least one game against a team from T4 in slot " << printSet(slots2);
-			(type == HARD) ? c.first += penalty : c.second += penalty;
-			std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-			std::cout << "T1: " << printSet(allTeams1) << std::endl;
-			std::cout << "T2: " << printSet(allTeams2) << std::endl;
-			std::cout << "T3: " << printSet(allTeams3) << std::endl;
-			std::cout << "T4: " << printSet(allTeams4) << std::endl;
+			addDeviation(c, 1);
+			Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+			Instance::report() << "T1: " << printSet(allTeams1) << std::endl;
+			Instance::report() << "T2: " << printSet(allTeams2) << std::endl;
+			Instance::report() << "T3: " << printSet(allTeams3) << std::endl;
+			Instance::report() << "T4: " << printSet(allTeams4) << std::endl;
 		}
 	}
 	return c;
@@ -1109,24 +1201,30 @@ ObjCost BR1::checkConstr(){
 	 * breaks in S less than k min P or more than k max.
 	 **/
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
+	const PackedSchedule& ps = IN->getPackedSchedule();
+	const SlotMask mask = IN->collectSlotMask(slots, slotGroups);
 	for (auto t : allTeams) {
-		// Get all the games of the team
-		MeetingList meetings = IN->getMeetingsTeam({t}, HA);
-		meetings.sort(compMeetingScheduledSlot);
-
-		// Loop over all breaks
 		int br = 0;
-		HomeMode m1;
-		HomeMode m2 = HA; // Make sure the first game does not result in a break
+		if (ps.isValid()) {
+			br = ps.breaks(t->getId(), GENERALIZED, hMode, mask.data());
+		} else {
+			// Get all the games of the team
+			MeetingList meetings = IN->getMeetingsTeam({t}, HA);
+			meetings.sort(compMeetingScheduledSlot);
 
-		for (auto m : meetings) {
-			m1 = m2; 	// Game mode of previous period
-			m2 = (m->getFirstTeam() == t) ? H : A;
-			if (m1 == m2 && (m2 == hMode || hMode==HA) && allSlots.count(m->getAssignedSlot())) { 
-				// Break with correct home mode occuring in one of the specified slots
-				br++; 
+			// Loop over all breaks
+			HomeMode m1;
+			HomeMode m2 = HA; // Make sure the first game does not result in a break
+
+			for (auto m : meetings) {
+				m1 = m2; 	// Game mode of previous period
+				m2 = (m->getFirstTeam() == t) ? H : A;
+				if (m1 == m2 && (m2 == hMode || hMode==HA) && allSlots.count(m->getAssignedSlot())) { 
+					// Break with correct home mode occuring in one of the specified slots
+					br++; 
+				}
 			}
 		}
 
@@ -1146,13 +1244,13 @@ ObjCost BR1::checkConstr(){
 				}
 				break;
 			default:
-				std::cout << "ERROR in BR1 evaluaton. Mode should be EQ or LEQ."  << std::endl;
+				Instance::report() << "ERROR in BR1 evaluaton. Mode should be EQ or LEQ."  << std::endl;
 				abort();
 				
 		}
 		if (dev > 0) {
-			(type == HARD) ? c.first += penalty*dev : c.second += penalty*dev;
-			std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+			addDeviation(c, dev);
+			Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 		}
 	}	
 
@@ -1167,30 +1265,14 @@ BR2::BR2(CType c, int p, std::array<IdList, 2> teamIds, CompareMode mod2, int in
 }
 BR2::BR2 (CType c, int p) : Constraint(c,p, "BR2"){
 	if (c==HARD) {
-		std::cout << "Hard" << std::endl;
+		Instance::report() << "Hard" << std::endl;
 		// the total number of breaks in the competition is at most the total number of
 		// breaks in the partial timetable
 		
 		// Count the total number of breaks
 		int totNrBreaks = 0;
 		for (int t = 0; t < IN->getNrTeams(); ++t) {
-			// Loop over all breaks
-			HomeMode m1;
-			HomeMode m2 = HA; // Make sure the first game does not result in a break
-
-			// Get all the games of the team
-			MeetingList meetings = IN->getMeetingsTeam({IN->getTeam(t)}, HA);
-			meetings.sort(compMeetingScheduledSlot);
-
-			for (auto m : meetings) {
-				m1 = m2; 	// Game mode of previous period
-				m2 = (m->getFirstTeam()->getId() == t) ? H : A;
-				if (m1 == m2) { 
-					// Break with correct home mode occuring in one of the specified slots
-					totNrBreaks++; 
-				}
-			}	
-
+			totNrBreaks += IN->breaks(IN->getTeam(t));
 		}
 
 		//bMode = REGULAR;
@@ -1199,7 +1281,7 @@ BR2::BR2 (CType c, int p) : Constraint(c,p, "BR2"){
 		intp = totNrBreaks;
 		for(auto s : IN->getSlots()) slots.insert(s.second);
 	} else {
-		std::cout << "Soft" << std::endl;
+		Instance::report() << "Soft" << std::endl;
 		// the total number of breaks in the competition is at most |U|-2
 		//bMode = REGULAR;
 		for(auto t : IN->getTeams()) teams.insert(t.second);
@@ -1232,10 +1314,16 @@ ObjCost BR2::checkConstr(){
 	 * breaks in S and k .
 	 **/
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
 	int nrBreaks = 0;
+	const PackedSchedule& ps = IN->getPackedSchedule();
+	const SlotMask mask = IN->collectSlotMask(slots, slotGroups);
 	for (auto t : allTeams) {
+		if (ps.isValid()) {
+			nrBreaks += ps.breaks(t->getId(), GENERALIZED, HA, mask.data());
+			continue;
+		}
 		// Get all the games of the team
 		MeetingList meetings = IN->getMeetingsTeam({t}, HA);
 		meetings.sort(compMeetingScheduledSlot);
@@ -1265,13 +1353,13 @@ ObjCost BR2::checkConstr(){
 			}
 			break;
 		default:
-			std::cout << "ERROR in BR4 evaluaton. Mode should be EQ or LEQ."  << std::endl;
+			Instance::report() << "ERROR in BR4 evaluaton. Mode should be EQ or LEQ."  << std::endl;
 			abort();
 			
 	}
 	if (dev > 0) {	
-		(type == HARD) ? c.first += penalty*dev : c.second += penalty*dev;
-		std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+		addDeviation(c, dev);
+		Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 		std::set<int> leagueSet {};
 	}
 	return c;
@@ -1282,7 +1370,7 @@ BR3::BR3(CType c, int p, std::array<IdList, 2> teamIds, BreakMode mod1, HomeMode
 	for (auto id : teamIds[1]) { teamGroups.insert(Instance::get()->getTeamGroup(id)); }
 }
 BR3::BR3 (CType c, int p) : Constraint(c,p, "BR3"){
-	std::cout << "BR3 random generator not yet initialized!" << std::endl;
+	Instance::report() << "BR3 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap BR3::serialize(){
@@ -1299,7 +1387,41 @@ AttrMap BR3::serialize(){
 	return attrs;
 }
 ObjCost BR3::checkConstr(){
+	/**
+	 * Each team in team group T has at most k consecutive { regular, generalized }
+	 * { home breaks, away breaks, breaks }. A regular break occurs in two consecutive
+	 * time slots, a generalized break in two consecutive games of the team.
+	 * Each team in T triggers a deviation equal to the sum over all runs of consecutive
+	 * breaks of the number of breaks more than k.
+	 **/
 	ObjCost c = std::make_pair(0,0);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const PackedSchedule& ps = IN->getPackedSchedule();
+	for (auto t : allTeams) {
+		std::vector<int> runs;
+		if (ps.isValid()) {
+			runs = ps.breakRuns(t->getId(), bMode, hMode);
+		} else {
+			int run = 0;
+			for (auto g : breakPattern(t, bMode, hMode)) {
+				if (g.second) { run++; }
+				else if (run > 0) { runs.push_back(run); run = 0; }
+			}
+			if (run > 0) { runs.push_back(run); }
+		}
+
+		int dev = 0, longest = 0;
+		for (auto run : runs) {
+			dev += std::max(0, run - intp);
+			longest = std::max(longest, run);
+		}
+		if (dev > 0) {
+			addDeviation(c, dev);
+			std::stringstream msg;
+			msg << "Team " << t->getId() << " has " << longest << " consecutive " << BreakModeToStr[bMode] << " " << HomeModeToStr[hMode] << " breaks. Must be smaller than " << intp << ".";
+			Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+		}
+	}
 	return c;
 }
 
@@ -1310,7 +1432,7 @@ BR4::BR4(CType c, int p, CompareMode m, std::array<IdList, 2> teamIds, int min,
 	for (auto id : slotIds[1]) { slotGroups.insert(Instance::get()->getSlotGroup(id)); }
 }
 BR4::BR4 (CType c, int p) : Constraint(c,p, "BR4"){
-	std::cout << "BR4 random generator not yet initialized!" << std::endl;
+	Instance::report() << "BR4 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap BR4::serialize(){
@@ -1328,7 +1450,70 @@ AttrMap BR4::serialize(){
 	return attrs;
 }
 ObjCost BR4::checkConstr(){
+	/**
+	 * The number of teams in team group T with a break in a time slot of time group S
+	 * is { exactly, no more than, at least } min, for each time slot in S.
+	 * Each time slot in S triggers a deviation equal to the difference between the
+	 * number of breaks and min.
+	 **/
 	ObjCost c = std::make_pair(0,0);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
+
+	// Count the breaks per slot over all teams
+	std::map<int, int> nrBreaks;
+	for (auto s : allSlots) { nrBreaks[s->getId()] = 0; }
+	const PackedSchedule& ps = IN->getPackedSchedule();
+	if (ps.isValid()) {
+		const SlotMask mask = IN->collectSlotMask(slots, slotGroups);
+		SlotMask row(ps.getNrWords());
+		for (auto t : allTeams) {
+			ps.breakRow(t->getId(), GENERALIZED, HA, row.data());
+			for (int w = 0; w < ps.getNrWords(); ++w) {
+				for (uint64_t bits = row[w] & mask[w]; bits; bits &= bits - 1) {
+					nrBreaks[w*64 + __builtin_ctzll(bits)]++;
+				}
+			}
+		}
+	} else {
+		for (auto t : allTeams) {
+			for (auto g : breakPattern(t, GENERALIZED, HA)) {
+				if (g.second && nrBreaks.count(g.first)) { nrBreaks[g.first]++; }
+			}
+		}
+	}
+
+	for (auto br : nrBreaks) {
+		int dev = 0;
+		std::stringstream msg1;
+		switch (cMode) {
+			case EQ:
+				if (br.second != min) {
+					dev = std::abs(br.second - min);
+					msg1 << "Slot " << br.first << " has " << br.second << " breaks. Must be equal to " << min << ".";
+				}
+				break;
+			case LEQ:
+				if (br.second > min) {
+					dev = br.second - min;
+					msg1 << "Slot " << br.first << " has " << br.second << " breaks. Must be smaller than " << min << ".";
+				}
+				break;
+			case GEQ:
+				if (br.second < min) {
+					dev = min - br.second;
+					msg1 << "Slot " << br.first << " has " << br.second << " breaks. Must be larger than " << min << ".";
+				}
+				break;
+			default:
+				Instance::report() << "ERROR in BR4 evaluaton. Mode should be EQ, LEQ, or GEQ."  << std::endl;
+				abort();
+		}
+		if (dev > 0) {
+			addDeviation(c, dev);
+			Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg1.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+		}
+	}
 	return c;
 }
 
@@ -1339,7 +1524,7 @@ FA1::FA1(CType c, int p, std::array<IdList, 2> teamIds, int intp, std::array<IdL
 	for (auto id : slotIds[1]) { slotGroups.insert(Instance::get()->getSlotGroup(id)); }
 }
 FA1::FA1 (CType c, int p) : Constraint(c,p, "FA1"){
-	std::cout << "FA1 random generator not yet initialized!" << std::endl;
+	Instance::report() << "FA1 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap FA1::serialize(){
@@ -1363,47 +1548,55 @@ ObjCost FA1::checkConstr(){
 	   home and away games more than k over all time slots in S .
 	 **/
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
+	const PackedSchedule& ps = IN->getPackedSchedule();
+	const SlotMask mask = IN->collectSlotMask(slots, slotGroups);
 	for(auto t : allTeams){
-		MeetingList meetings = IN->getMeetingsTeam({t}, HA);
-		if (meetings.size() == 0) {
-			continue;
-		}
-		meetings.sort(compMeetingScheduledSlot);
-
-		// Strategy: set the difference, and look one meeting ahead
-		// If next meeting has same home advanatge, then wait (difference will further increase)
-		// If next meeting has different home advantage: check whether difference is unacceptable
-		int difference = 1; // After the first round, the difference is always one
 		int maxDifference = -1, maxSlot=-1;
-		bool home = ((*meetings.begin())->getFirstTeam() == t); // Home advantage of first meeting
-		bool nextHome;
-		const MeetingListIt start = meetings.begin();
-		const MeetingListIt end = std::prev(meetings.end());
-		const MeetingListIt penultimate = std::prev(end);
-		for(MeetingListIt it = start; it != end; ++it){
-			nextHome = ((*std::next(it))->getFirstTeam() == t);
-			if (home != nextHome) {
-				difference = 0;
-			} else { // Same home advantage
-				difference++;
-				if (difference > maxDifference && allSlots.count((*std::next(it))->getAssignedSlot())) { // New largest difference on one of the slots in slot set
-					maxDifference = difference;
-					maxSlot = (*std::next(it))->getAssignedSlot()->getId();
-				}
-			} 
-			home = nextHome;
+		if (ps.isValid()) {
+			ps.balance(t->getId(), mask, maxDifference, maxSlot);
+		} else {
+			balance(t, allSlots, maxDifference, maxSlot);
 		}
 		if (maxDifference > intp) {
-			(type == HARD) ? c.first += penalty*maxDifference : c.second += penalty*maxDifference;
+			addDeviation(c, maxDifference);
 			std::stringstream msg;
 			msg << "K-balancedness-index for team " << t->getId() << " is " << maxDifference << " in period "  << maxSlot << ".";
-			std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+			Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 		}
 	}
 	return c;
 }
+void FA1::balance(Team* t, const SlotSet& allSlots, int& maxDifference, int& maxSlot){
+	MeetingList meetings = IN->getMeetingsTeam({t}, HA);
+	if (meetings.size() == 0) {
+		return;
+	}
+	meetings.sort(compMeetingScheduledSlot);
+
+	// Strategy: set the difference, and look one meeting ahead
+	// If next meeting has same home advanatge, then wait (difference will further increase)
+	// If next meeting has different home advantage: check whether difference is unacceptable
+	int difference = 1; // After the first round, the difference is always one
+	bool home = ((*meetings.begin())->getFirstTeam() == t); // Home advantage of first meeting
+	bool nextHome;
+	const MeetingListIt start = meetings.begin();
+	const MeetingListIt end = std::prev(meetings.end());
+	for(MeetingListIt it = start; it != end; ++it){
+		nextHome = ((*std::next(it))->getFirstTeam() == t);
+		if (home != nextHome) {
+			difference = 0;
+		} else { // Same home advantage
+			difference++;
+			if (difference > maxDifference && allSlots.count((*std::next(it))->getAssignedSlot())) { // New largest difference on one of the slots in slot set
+				maxDifference = difference;
+				maxSlot = (*std::next(it))->getAssignedSlot()->getId();
+			}
+		} 
+		home = nextHome;
+	}
+}
 
 FA2::FA2(CType c, int p, std::array<IdList, 2> teamIds, HomeMode mode, int intp, std::array<IdList, 2> slotIds) : Constraint(c,p, "FA2"), hMode(mode), intp(intp) {
 	for (auto id : teamIds[0]) { teams.insert(Instance::get()->getTeam(id)); }
@@ -1442,8 +1635,8 @@ ObjCost FA2::checkConstr(){
 	 **/
 
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
 
 	// Querying games of teams is rather expensive. First IN->collect number of teams played per team, thereafter compare
 	// Step 1: IN->collect games played per team per slot
@@ -1476,7 +1669,7 @@ ObjCost FA2::checkConstr(){
 			prevSlotId = slotId;
 		}
 		// Fill in slots after last game
-		for (int i = prevSlotId; i < nrCols; ++i) {
+		for (int i = prevSlotId + 1; i < nrCols; ++i) {
 			gamesPlayed[tId][i] = nrPlayed;
 		}	
 	}
@@ -1497,10 +1690,10 @@ ObjCost FA2::checkConstr(){
 				}
 			}
 			if (maxDifference > intp) {
-				(type == HARD) ? c.first += penalty*(maxDifference-intp) : c.second += penalty*(maxDifference-intp);
+				addDeviation(c, maxDifference-intp);
 				std::stringstream msg;
 				msg << HomeModeToStr[hMode] << "-ranking-balancedness-index between team " << j << " and team " << k << " has a value of " << maxDifference << " in slot " << period << ". Max value is " << intp << ".";
-				std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+				Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 			}
 		}
 	}
@@ -1515,10 +1708,10 @@ ObjCost FA2::checkConstr(){
 			for (int k = j + 1; k < nrRows; ++k) {
 				int difference = std::abs(gamesPlayed[j][i] - gamesPlayed[k][i]);
 				if (difference > intp) {
-					(type == HARD) ? c.first += penalty*(difference-intp) : c.second += penalty*(difference-intp);
+					addDeviation(c, difference-intp);
 					std::stringstream msg;
 					msg << HomeModeToStr[hMode] << "-ranking-balancedness-index between team " << j << " and team " << k << " in slot " << i << " has a value of " << difference << " in slot " << i << ". Max value is " << intp << ".";
-					std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+					Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 				}
 			}
 		}
@@ -1539,7 +1732,7 @@ FA3::FA3(CType c, int p, std::array<IdList, 2> teamIds) : Constraint(c,p, "FA3")
 	for (auto id : teamIds[1]) { teamGroups.insert(Instance::get()->getTeamGroup(id)); }
 }
 FA3::FA3 (CType c, int p) : Constraint(c,p, "FA3"){
-	std::cout << "FA3 random generator not yet initialized!" << std::endl;
+	Instance::report() << "FA3 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap FA3::serialize(){
@@ -1560,7 +1753,7 @@ ObjCost FA3::checkConstr(){
 	 * number of consecutive mutual games with the same home-away assignment.
 	 **/
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
 	// Check for each pair whether the games alternate
 	TeamSetIt start = allTeams.begin();
 	TeamSetIt end1 = std::prev(allTeams.end());
@@ -1576,10 +1769,10 @@ ObjCost FA3::checkConstr(){
 				if (t1 == t2) { difference++; }	
 			}
 			if (difference > 0) {
-				(type == HARD) ? c.first += penalty*difference : c.second += penalty*difference;
+				addDeviation(c, difference);
 				std::stringstream msg;
 				msg << "Team " << (*it1)->getId() << " and team " << (*it2)->getId() << " do not play alternately." << difference << " times violated.";
-				std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+				Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 			}
 		}	
 	}	
@@ -1592,7 +1785,7 @@ FA4::FA4(CType c, int p, std::array<IdList, 2> teamIds, int intp) : Constraint(c
 	for (auto id : teamIds[1]) { teamGroups.insert(Instance::get()->getTeamGroup(id)); }
 }
 FA4::FA4 (CType c, int p) : Constraint(c,p, "FA4"){
-	std::cout << "FA4 random generator not yet initialized!" << std::endl;
+	Instance::report() << "FA4 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap FA4::serialize(){
@@ -1607,7 +1800,32 @@ AttrMap FA4::serialize(){
 	return attrs;
 }
 ObjCost FA4::checkConstr(){
+	/**
+	 * Each team in team group T has a difference in played home and away games
+	 * that is at most k.
+	 * Each team in T triggers a deviation equal to the difference in played home
+	 * and away games more than k.
+	 **/
 	ObjCost c = std::make_pair(0,0);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const PackedSchedule& ps = IN->getPackedSchedule();
+	for (auto t : allTeams) {
+		int nrHome, nrAway;
+		if (ps.isValid()) {
+			nrHome = ps.nrGames(t->getId(), H);
+			nrAway = ps.nrGames(t->getId(), A);
+		} else {
+			nrHome = IN->getMeetingsTeam({t}, H).size();
+			nrAway = IN->getMeetingsTeam({t}, A).size();
+		}
+		const int dev = std::abs(nrHome - nrAway) - intp;
+		if (dev > 0) {
+			addDeviation(c, dev);
+			std::stringstream msg;
+			msg << "Team " << t->getId() << " plays " << nrHome << " home and " << nrAway << " away games. Max difference: " << intp << ".";
+			Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+		}
+	}
 	return c;
 }
 
@@ -1631,7 +1849,7 @@ AttrMap FA5::serialize(){
 	return attrs;
 }
 FA5::FA5 (CType c, int p) : Constraint(c,p, "FA5"){
-	std::cout << "FA5 random generator not yet initialized!" << std::endl;
+	Instance::report() << "FA5 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 ObjCost FA5::checkConstr(){
@@ -1643,16 +1861,17 @@ ObjCost FA5::checkConstr(){
 	 **/
 	ObjCost c = std::make_pair(0,0);
 
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
 	int dist = 0;
 	for (auto t: allTeams) {
 		dist += Instance::get()->distance(t, allSlots);
 	}
 	if (dist > intp) {
+		addDeviation(c, dist - intp);
 		std::stringstream msg;
 		msg << "Total distance traveled by team group {" << printSet(allTeams) << "} during time group S is " << dist << ". Max allowed: " << intp;
-		std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+		Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 	}
 
 	return c;
@@ -1664,7 +1883,7 @@ FA6::FA6(CType c, int p, std::array<IdList, 2> slotIds, int intp) : Constraint(c
 	for (auto id : slotIds[1]){ slotGroups.insert(Instance::get()->getSlotGroup(id)); }
 }
 FA6::FA6 (CType c, int p) : Constraint(c,p, "FA6"){
-	std::cout << "FA6 random generator not yet initialized!" << std::endl;
+	Instance::report() << "FA6 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap FA6::serialize(){
@@ -1685,7 +1904,7 @@ ObjCost FA6::checkConstr(){
 	 * Time group S triggers a penalty equal to the total cost more than k .
 	 **/
 	ObjCost c = std::make_pair(0,0);
-	SlotSet allSlots = IN->collectSlots(slots, slotGroups);
+	const SlotSet& allSlots = IN->getInternedSlots(IN->internSlots(slots, slotGroups));
 	int totalCost=0;
 	for (auto m : IN->getMeetingsSlot(allSlots)) {
 		int cost = IN->getCost(m->getFirstTeam(), m->getSecondTeam(), m->getAssignedSlot());
@@ -1693,11 +1912,11 @@ ObjCost FA6::checkConstr(){
 	}
 	int difference = totalCost - intp;
 	if (difference > 0) {
-		(type == HARD) ? c.first += penalty*difference : c.second += penalty*difference;
+		addDeviation(c, difference);
 		std::stringstream msg;
 		msg << "Total cost of all games on given time slots is " << totalCost << ". Allowed: " << intp << ".";
-		std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
-		std::cout << "Slots: " << printSet(allSlots) << std::endl;
+		Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+		Instance::report() << "Slots: " << printSet(allSlots) << std::endl;
 	}
 	return c;
 }
@@ -1732,27 +1951,38 @@ ObjCost SE1::checkConstr(){
 		of time slots less than k for all consecutive mutual games.
 	**/
 	ObjCost c = std::make_pair(0,0);
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
+	const PackedSchedule& ps = IN->getPackedSchedule();
+	std::vector<int> slotIds;
 	TeamSetIt start = allTeams.begin();
 	TeamSetIt end1 = std::prev(allTeams.end());
 	TeamSetIt end2 = allTeams.end();
 	for(TeamSetIt it1 = start; it1 != end1; ++it1){
 		for (TeamSetIt it2 = std::next(it1); it2 != end2; ++it2) {
-			MeetingList meetings = IN->getMeetingsTeamTeam({*it1}, {*it2}, HA);
-			if (meetings.size() < 2) { continue; }
-			meetings.sort(compMeetingScheduledSlot);
-			int slotId1 = (*meetings.begin())->getAssignedSlot()->getId();
-			MeetingListIt start = std::next(meetings.begin());
-			MeetingListIt end = meetings.end();
-			for (MeetingListIt it = start; it != end; ++it) {
-				int slotId2 = (*it)->getAssignedSlot()->getId();
+			// Slots of the mutual games in increasing order, scanned from the slot rows of both pairs on the bitboards
+			slotIds.clear();
+			if (ps.hasBoards()) {
+				const uint64_t* home = ps.getPairRow((*it1)->getId(), (*it2)->getId());
+				const uint64_t* away = ps.getPairRow((*it2)->getId(), (*it1)->getId());
+				for (int w = 0; w < ps.getNrWords(); ++w) {
+					for (uint64_t bits = home[w] | away[w]; bits; bits &= bits - 1) { slotIds.push_back(64*w + __builtin_ctzll(bits)); }
+				}
+			} else {
+				MeetingList meetings = IN->getMeetingsTeamTeam({*it1}, {*it2}, HA);
+				meetings.sort(compMeetingScheduledSlot);
+				for (auto m : meetings) { slotIds.push_back(m->getAssignedSlot()->getId()); }
+			}
+			if (slotIds.size() < 2) { continue; }
+			int slotId1 = slotIds[0];
+			for (size_t i = 1; i < slotIds.size(); ++i) {
+				int slotId2 = slotIds[i];
 				int difference = slotId2 - slotId1 - 1; // BETWEEN two games
 				difference = std::max(0, min - difference);
 				if (difference > 0) {
-					(type == HARD) ? c.first += penalty*difference : c.second += penalty*difference;
+					addDeviation(c, difference);
 					std::stringstream msg;
 					msg << "Team " << (*it1)->getId() << " and team " << (*it2)->getId() << " meet each other in slot " << slotId1 << " and " << slotId2 << ". Min distance is " << min;
-					std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
+					Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;
 				}
 				slotId1 = slotId2;
 			}
@@ -1766,7 +1996,7 @@ SE2::SE2(CType c, int p, std::array<IdList, 2> teamIds, SlotPairList slotPairing
 	for (auto id : teamIds[1]){ teamGroups.insert(Instance::get()->getTeamGroup(id)); }	
 }
 SE2::SE2 (CType c, int p) : Constraint(c,p, "SE2"){
-	std::cout << "SE2 random generator not yet initialized!" << std::endl;
+	Instance::report() << "SE2 random generator not yet initialized!" << std::endl;
 	assert ( 2 < 1);
 }
 AttrMap SE2::serialize(){
@@ -1795,7 +2025,7 @@ ObjCost SE2::checkConstr(){
 
 	ObjCost c = std::make_pair(0,0);
 
-	TeamSet allTeams = IN->collectTeams(teams, teamGroups);
+	const TeamSet& allTeams = IN->internTeams(teams, teamGroups);
 	TeamSetIt start = allTeams.begin();
 	TeamSetIt end1 = std::prev(allTeams.end());
 	TeamSetIt end2 = allTeams.end();
@@ -1808,10 +2038,10 @@ ObjCost SE2::checkConstr(){
 				int nrMeetings1 = IN->getMeetingsTeamTeamSlot({*it1}, {*it2}, {IN->getSlot(slotId1)}, HA).size();
 				int nrMeetings2 = IN->getMeetingsTeamTeamSlot({*it1}, {*it2}, {IN->getSlot(slotId2)}, HA).size();
 				if (nrMeetings1 != nrMeetings2) {
-					(type == HARD) ? c.first += penalty : c.second += penalty;
+					addDeviation(c, 1);
 					std::stringstream msg;
 					msg << "Team " << (*it1)->getId() << " and team " << (*it2)->getId() << " meet each other in slot " << (nrMeetings1 == 1 ? slotId1 : slotId2) << " but not in " << (nrMeetings1 == 1 ? slotId2 : slotId1) << ".";
-					std::cout << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;	
+					Instance::report() << std::setw(10) << name << std::setw(10) << " " << std::setw(50) << msg.str() << std::setw(10) << c.first << std::setw(10) << c.second << std::endl;	
 				}
 			}
 		}
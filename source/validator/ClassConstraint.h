@@ -24,6 +24,7 @@
 // Abstract Base Class
 class Constraint
 {
+friend class Instance;
 public:
 	// constructors
 	Constraint(CType c, int p, std::string name) : type(c), penalty(p), name(name) {};
@@ -46,11 +47,21 @@ public:
 	CType getType() const { return type; }
 	void setType(const CType t) { type = t; }
 
+	// Total deviation found by the last check on the schedule of the calling thread, independent of the penalty and type
+	int getDeviation() const;
+
+	// Cost of a deviation under the current penalty and type
+	ObjCost weigh(const int dev) const { return (type == HARD) ? std::make_pair(penalty*dev, 0) : std::make_pair(0, penalty*dev); }
+
 protected:
+	// Add a violation to the cost of a check, and its deviation to the total deviation
+	void addDeviation(ObjCost& c, const int dev) { deviation += dev; (type == HARD) ? c.first += penalty*dev : c.second += penalty*dev; }
+
 	// Data
 	CType type; 		// HARD or SOFT
 	int penalty; 		
 	const std::string name;
+	static thread_local int deviation; 	// Deviation of the check on this thread, reset by Instance::evaluate
 };
 
 class BA1 : public Constraint 
@@ -288,6 +299,9 @@ public:
 	int intp;
 	SlotSet slots;
 	SlotGroupSet slotGroups;
+private:
+	// Largest home/away difference of a team over the slots in allSlots, from its sorted meetings
+	void balance(Team* t, const SlotSet& allSlots, int& maxDifference, int& maxSlot);
 };
 
 class FA2 : public Constraint{
@@ -0,0 +1,140 @@
+#include "ClassConstraintBatch.h"
+
+// Include other
+#include "ClassSlot.h"
+#include "ClassTeam.h"
+
+ConstraintBatch::ConstraintBatch(const Kind kind, const HomeMode mode, const int nrTeams, const int nrSlots) : kind(kind), mode(mode),
+	nrTeams(nrTeams), nrSlots(nrSlots), team1Offsets(1, 0), slotOffsets(1, 0), countOffsets(1, 0)
+{
+}
+
+int ConstraintBatch::add(const Constraint* c, const TeamSet& teams1, const TeamSet& teams2, const SlotSet& slots){
+	const int i = members.size();
+	members.push_back(c);
+	isTeam1.resize((i + 1)*nrTeams, 0);
+	team2Index.resize((i + 1)*nrTeams, -1);
+	for (auto t : teams1) {
+		team1Ids.push_back(t->getId());
+		isTeam1[i*nrTeams + t->getId()] = 1;
+	}
+	team1Offsets.push_back(team1Ids.size());
+	int j = 0;
+	for (auto t : teams2) { team2Index[i*nrTeams + t->getId()] = j++; }
+	nrTeams2.push_back(teams2.size());
+	for (auto s : slots) { slotIds.push_back(s->getId()); }
+	slotOffsets.push_back(slotIds.size());
+	if (nrTeams <= PackedSchedule::maxBoardTeams) {
+		TeamMask mask1 = 0, mask2 = 0;
+		for (auto t : teams1) { mask1 |= (TeamMask) 1 << t->getId(); }
+		for (auto t : teams2) { mask2 |= (TeamMask) 1 << t->getId(); }
+		masks1.push_back(mask1);
+		masks2.push_back(mask2);
+	}
+
+	int nrCounts = 0;
+	switch (kind) {
+		case CA2GLOBAL:	nrCounts = teams1.size(); break;
+		case CA2EVERY:	nrCounts = teams1.size()*teams2.size(); break;
+		default:	nrCounts = slots.size(); break;
+	}
+	countOffsets.push_back(countOffsets.back() + nrCounts);
+	return i;
+}
+
+void ConstraintBatch::finish(){
+	// Invert the slot rows: count the entries per slot, and fill them in order of member
+	slotRowOffsets.assign(nrSlots + 1, 0);
+	for (auto s : slotIds) { slotRowOffsets[s + 1]++; }
+	for (int s = 0; s < nrSlots; ++s) { slotRowOffsets[s + 1] += slotRowOffsets[s]; }
+	slotEntries.assign(slotIds.size(), std::make_pair(0, 0));
+	std::vector<int> next(slotRowOffsets.begin(), slotRowOffsets.end() - 1);
+	for (int i = 0; i < getNrMembers(); ++i) {
+		for (int p = slotOffsets[i]; p < slotOffsets[i+1]; ++p) {
+			slotEntries[next[slotIds[p]]++] = std::make_pair(i, p - slotOffsets[i]);
+		}
+	}
+}
+
+void ConstraintBatch::evaluate(const PackedSchedule& ps, std::vector<int>& counts) const{
+	counts.assign(countOffsets.back(), 0);
+	switch (kind) {
+		case CA4ANY:
+			switch (mode) {
+				case H:	evaluateCA4<H>(ps, counts); break;
+				case A:	evaluateCA4<A>(ps, counts); break;
+				default: evaluateCA4<HA>(ps, counts); break;
+			}
+			break;
+		default:
+			switch (mode) {
+				case H:	evaluateCA2<H>(ps, counts); break;
+				case A:	evaluateCA2<A>(ps, counts); break;
+				default: evaluateCA2<HA>(ps, counts); break;
+			}
+			break;
+	}
+}
+
+// Games of every team of T1 against the teams of T2, as Instance::getMeetingsTeamTeamSlot with teams1 = {t}:
+// in total (GLOBAL), or per team of T2 (EVERY)
+template <HomeMode m>
+void ConstraintBatch::evaluateCA2(const PackedSchedule& ps, std::vector<int>& counts) const{
+	const bool every = (kind == CA2EVERY);
+	for (int s = 0; s < nrSlots; ++s) {
+		for (int e = slotRowOffsets[s]; e < slotRowOffsets[s+1]; ++e) {
+			const int i = slotEntries[e].first;
+			const int* index2 = &team2Index[i*nrTeams];
+			int* count = &counts[countOffsets[i]];
+			for (int k = team1Offsets[i]; k < team1Offsets[i+1]; ++k) {
+				const int t = team1Ids[k];
+				const int o = ps.getOpponent(t, s);
+				if (o == -1 || (m != HA && ps.isHome(t, s) != (m == H)) || index2[o] == -1) { continue; }
+				count[every ? (k - team1Offsets[i])*nrTeams2[i] + index2[o] : k - team1Offsets[i]]++;
+			}
+		}
+	}
+}
+
+// Games in every slot of S with a home team in T1 and an away team in T2 (H), the reverse (A), or either (HA), as
+// Instance::getMeetingsTeamTeamSlot. On the bitboards, the away teams of the hosts of a member are masked with T1 or T2.
+// Otherwise, the games of a slot are collected once for all members
+template <HomeMode m>
+void ConstraintBatch::evaluateCA4(const PackedSchedule& ps, std::vector<int>& counts) const{
+	if (ps.hasBoards()) {
+		for (int s = 0; s < nrSlots; ++s) {
+			for (int e = slotRowOffsets[s]; e < slotRowOffsets[s+1]; ++e) {
+				const int i = slotEntries[e].first;
+				const TeamMask teams1 = masks1[i], teams2 = masks2[i];
+				int nr = 0;
+				for (TeamMask hosts = (m == H ? teams1 : (m == A ? teams2 : teams1 | teams2)); hosts; hosts &= hosts - 1) {
+					const int h = __builtin_ctzll(hosts);
+					const TeamMask away = ((m != A && ((teams1 >> h) & 1)) ? teams2 : 0) | ((m != H && ((teams2 >> h) & 1)) ? teams1 : 0);
+					nr += __builtin_popcountll(ps.boardRow<H>(h, s) & away);
+				}
+				counts[countOffsets[i] + slotEntries[e].second] = nr;
+			}
+		}
+		return;
+	}
+
+	std::vector<std::pair<int, int>> games;
+	for (int s = 0; s < nrSlots; ++s) {
+		if (slotRowOffsets[s] == slotRowOffsets[s+1]) { continue; }
+		games.clear();
+		for (int h = 0; h < nrTeams; ++h) {
+			const int a = ps.getOpponent(h, s);
+			if (a != -1 && ps.isHome(h, s)) { games.push_back(std::make_pair(h, a)); }
+		}
+		for (int e = slotRowOffsets[s]; e < slotRowOffsets[s+1]; ++e) {
+			const int i = slotEntries[e].first;
+			const char* team1 = &isTeam1[i*nrTeams];
+			const int* index2 = &team2Index[i*nrTeams];
+			int nr = 0;
+			for (auto g : games) {
+				if ((m != A && team1[g.first] && index2[g.second] != -1) || (m != H && team1[g.second] && index2[g.first] != -1)) { nr++; }
+			}
+			counts[countOffsets[i] + slotEntries[e].second] = nr;
+		}
+	}
+}
@@ -0,0 +1,73 @@
+/*********************************************************************************************************
+ConstraintBatch class evaluates a group of constraints of the same type and modes in one pass over the packed schedule
+	kind, mode:	CA2 with global mode GLOBAL or EVERY, or CA4 with either global mode, and the home mode of all members
+	teams1:		compressed sparse rows with the ids of T1 of every member, in the order of its interned team set
+	slots:		compressed sparse rows with the ids of S of every member, in the order of its interned slot set
+	isTeam1:	members x teams: 1 if the team is in T1 of the member
+	team2Index:	members x teams: position of the team in T2 of the member, or -1
+	masks1/masks2:	T1 and T2 of every member as team masks, for leagues that fit the bitboards of the packed schedule
+	slotRows:	compressed sparse rows with the members whose S contains a slot, and the position of the slot in S
+	counts:		games per team of T1 (CA2 GLOBAL), per team of T1 and team of T2 (CA2 EVERY), or per slot of S (CA4)
+A pass visits every slot once, and only the members whose slots contain it. The members turn their counts into their
+deviation and report lines, in their own order, such that both are those of a check of the member on its own.
+CA1 is not batched: it counts the games of a team in S by the prefix sums of the packed schedule, one lookup per range
+of consecutive slots of S, which is already less work than a visit of every slot of S.
+*********************************************************************************************************/
+#ifndef CLASSCONSTRAINTBATCH_H
+#define CLASSCONSTRAINTBATCH_H
+
+// Include std
+#include <vector>
+
+// Include other
+#include "Globals.h"
+#include "ClassPackedSchedule.h"
+
+class Constraint;
+
+class ConstraintBatch
+{
+public:
+	enum Kind {CA2GLOBAL, CA2EVERY, CA4ANY};
+
+	ConstraintBatch(const Kind kind, const HomeMode mode, const int nrTeams, const int nrSlots);
+	~ConstraintBatch() {}
+
+	Kind getKind() const { return kind; }
+	HomeMode getMode() const { return mode; }
+	int getNrMembers() const { return members.size(); }
+
+	// Add a member with its interned team and slot sets, and return its index
+	int add(const Constraint* c, const TeamSet& teams1, const TeamSet& teams2, const SlotSet& slots);
+	// Build the slot rows, after the last member is added
+	void finish();
+
+	// Counts of all members on a valid packed schedule
+	void evaluate(const PackedSchedule& ps, std::vector<int>& counts) const;
+	// Offset of the counts of member i
+	int getOffset(const int i) const { return countOffsets[i]; }
+
+private:
+	template <HomeMode m> void evaluateCA2(const PackedSchedule& ps, std::vector<int>& counts) const;
+	template <HomeMode m> void evaluateCA4(const PackedSchedule& ps, std::vector<int>& counts) const;
+
+	Kind kind;
+	HomeMode mode;
+	int nrTeams;
+	int nrSlots;
+	std::vector<const Constraint*> members;
+	std::vector<int> team1Offsets; 		// T1 of member i: team1Ids[team1Offsets[i]..team1Offsets[i+1]-1]
+	std::vector<int> team1Ids;
+	std::vector<int> nrTeams2; 		// |T2| of every member
+	std::vector<int> slotOffsets; 		// S of member i: slotIds[slotOffsets[i]..slotOffsets[i+1]-1]
+	std::vector<int> slotIds;
+	std::vector<char> isTeam1; 		// members x nrTeams
+	std::vector<int> team2Index; 		// members x nrTeams
+	std::vector<TeamMask> masks1; 		// Only if nrTeams <= PackedSchedule::maxBoardTeams
+	std::vector<TeamMask> masks2;
+	std::vector<int> countOffsets; 		// Counts of member i: counts[countOffsets[i]..countOffsets[i+1]-1]
+	std::vector<int> slotRowOffsets; 	// Entries of slot s: slotEntries[slotRowOffsets[s]..slotRowOffsets[s+1]-1]
+	std::vector<std::pair<int, int>> slotEntries; 	// (member, position of the slot in its S)
+};
+
+#endif /* CLASSCONSTRAINTBATCH_H */
@@ -0,0 +1,66 @@
+/*********************************************************************************************************
+GroupIndex class stores the membership of a type of groups (team groups, slot groups) as bit masks
+	masks:		one bit row per group over all member ids, packed in 64-bit words
+Groups are looked up by id, such that the union of groups is a word-wise OR of their masks, whose set bits are the
+member ids in increasing order. The member sets of the groups remain the source of truth: the owner builds the index
+from them on the first query after a member or group is added, see Instance::indexGroups. The index is only valid if
+member ids run from 0 to n-1 and group ids are non-negative. Otherwise, the caller falls back to the member sets.
+*********************************************************************************************************/
+#ifndef CLASSGROUPINDEX_H
+#define CLASSGROUPINDEX_H
+
+// Include std
+#include <cstdint>
+#include <map>
+#include <vector>
+
+template <typename G>
+class GroupIndex
+{
+public:
+	GroupIndex() {}
+	~GroupIndex() {}
+
+	// Rebuild the index from all groups, with member ids in 0..nrMembers-1
+	void build(const std::map<int, G*>& groupMap, const int nrMembers) {
+		const int nrGroups = groupMap.size();
+		nrWords = (nrMembers + 63) / 64;
+		rows.clear();
+		masks.assign(nrGroups*nrWords, 0);
+		valid = groupMap.empty() || (groupMap.begin()->first >= 0 && groupMap.rbegin()->first < 2*nrGroups + 64);
+		if (!valid) { return; }
+
+		rows.assign(groupMap.empty() ? 0 : groupMap.rbegin()->first + 1, -1);
+		int r = 0;
+		for (auto g : groupMap) {
+			rows[g.first] = r;
+			for (auto it = g.second->getFirstMember(); it != g.second->getLastMember(); ++it) {
+				const int id = (*it)->getId();
+				if (id < 0 || id >= nrMembers) {
+					valid = false;
+					return;
+				}
+				masks[r*nrWords + id/64] |= (uint64_t) 1 << (id%64);
+			}
+			r++;
+		}
+	}
+
+	bool isValid() const { return valid; }
+	int getNrWords() const { return nrWords; }
+
+	// Bit row of the members of group, or NULL if the group is not indexed
+	const uint64_t* getMask(const G* g) const {
+		const int id = g->getId();
+		if (!valid || id < 0 || id >= (int) rows.size() || rows[id] < 0) { return NULL; }
+		return &masks[rows[id]*nrWords];
+	}
+
+private:
+	bool valid = false;
+	int nrWords = 0; 			// Number of 64-bit words in a mask
+	std::vector<int> rows; 			// rows[group id]: row of the group, or -1
+	std::vector<uint64_t> masks; 		// nrGroups x nrWords
+};
+
+#endif /* CLASSGROUPINDEX_H */
@@ -0,0 +1,42 @@
+/*********************************************************************************************************
+IdIndex class resolves entity ids by an array lookup
+Teams and slots are numbered 0..|T|-1 and 0..|S|-1, and groups and leagues usually are as well. The index keeps
+every entity with an id in this range in a vector, next to the id map of the Instance class that owns the
+entities. Ids out of range, such as negative or very large ids, are resolved by the map instead.
+*********************************************************************************************************/
+#ifndef CLASSIDINDEX_H
+#define CLASSIDINDEX_H
+
+// Include std
+#include <map>
+#include <vector>
+
+template <typename T>
+class IdIndex
+{
+public:
+	IdIndex() {}
+	~IdIndex() {}
+
+	// Add an entity with the given id; nrEntities is the size of the id map including the entity
+	void insert(const int id, T* x, const int nrEntities) {
+		if (id < 0 || id >= 2*nrEntities + 64) { return; }
+		if (id >= (int) dense.size()) { dense.resize(id + 1, NULL); }
+		dense[id] = x;
+	}
+
+	void erase(const int id) {
+		if (id >= 0 && id < (int) dense.size()) { dense[id] = NULL; }
+	}
+
+	// Entity with the given id: throws std::out_of_range if the map has no such id, as std::map::at
+	T* at(const int id, const std::map<int, T*>& map) const {
+		if (id >= 0 && id < (int) dense.size() && dense[id] != NULL) { return dense[id]; }
+		return map.at(id);
+	}
+
+private:
+	std::vector<T*> dense; 			// dense[id], or NULL if there is no entity with this id in the index
+};
+
+#endif /* CLASSIDINDEX_H */
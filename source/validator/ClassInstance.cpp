@@ -1,9 +1,21 @@
 #include "ClassInstance.h"
 
+// Include std
+#include <atomic>
+#include <thread>
+
 // Allocating and initializing Instance static data member.
 // Lazy initialization: the pointer is being allocated, not the object itself.
 Instance *Instance::iInstance = 0;
 
+// Query statistics of the constraint this thread is checking, NULL outside Instance::evaluate
+static thread_local QueryStats* currentQueries = NULL;
+
+// True on the threads of Instance::evaluateSchedules, which discard the reports of the checks
+static thread_local bool quietReport = false;
+
+Instance::Instance() : baseGames(new BA1(HARD, 1)), baseSlots(new BA2(HARD, 2)) {}
+
 Instance::~Instance(){
 	// Free all memory
 	
@@ -44,15 +56,12 @@ Instance::~Instance(){
 		it = leagues.erase(it);		
 	}	
 
-	// Meetings
-	for (MeetingListIt it = meetings.begin(); it != meetings.end(); ++it) {
-		delete *it;
-	}
-
 	// Constraints
 	for (ConstraintListIt it = constraints.begin(); it != constraints.end(); ++it) {
 		delete *it;	
 	}	
+	delete baseGames;
+	delete baseSlots;
 }
 
 void Instance::addLeague(League* l){
@@ -65,6 +74,7 @@ void Instance::addLeague(League* l){
 		}
 		else{
 			leagues[l->getId()] = l;
+			leagueIndex.insert(l->getId(), l, leagues.size());
 		}
 		// Add league to members of its league groups
 		for (auto lg:l->getLeagueGroups()){
@@ -88,6 +98,7 @@ void Instance::addLeagueGroup(LeagueGroup* lg){
 		}
 		else{
 			leagueGroups[lg->getId()] = lg;
+			leagueGroupIndex.insert(lg->getId(), lg, leagueGroups.size());
 		}
 	}
 	catch(InterfaceReadingException e) {
@@ -107,6 +118,9 @@ void Instance::addSlot(Slot* s){
 		}
 		else{
 			slots[s->getId()] = s;
+			slotIndex.insert(s->getId(), s, slots.size());
+			groupsIndexed = false;
+			modelVersion = ScheduleState::nextVersion();
 		}
 		// Add slot to members of its slot groups
 		for (auto sg:s->getSlotGroups()){
@@ -136,6 +150,9 @@ void Instance::removeSlot(Slot* s) {
 
             // Remove slot from the slot map
             slots.erase(s->getId());
+            slotIndex.erase(s->getId());
+            groupsIndexed = false;
+            modelVersion = ScheduleState::nextVersion();
         }
     }
     catch (InterfaceReadingException& e) {
@@ -155,6 +172,8 @@ void Instance::addSlotGroup(SlotGroup* sg){
 		}
 		else{
 			slotGroups[sg->getId()] = sg;
+			slotGroupIndex.insert(sg->getId(), sg, slotGroups.size());
+			groupsIndexed = false;
 		}
 	}
 	catch(InterfaceReadingException e) {
@@ -174,6 +193,9 @@ void Instance::addTeam(Team* t){
 		}
 		else{
 			teams[t->getId()] = t;
+			teamIndex.insert(t->getId(), t, teams.size());
+			groupsIndexed = false;
+			modelVersion = ScheduleState::nextVersion();
 		}
 		// Add team to members of its team groups
 		for (auto tg:t->getTeamGroups()){
@@ -199,6 +221,8 @@ void Instance::addTeamGroup(TeamGroup* tg){
 		}
 		else{
 			teamGroups[tg->getId()] = tg;
+			teamGroupIndex.insert(tg->getId(), tg, teamGroups.size());
+			groupsIndexed = false;
 		}
 	}
 	catch(InterfaceReadingException e) {
@@ -207,64 +231,57 @@ void Instance::addTeamGroup(TeamGroup* tg){
 		delete tg;
 	}
 }
-AttrMapList Instance::serializeDistances(){
-	AttrMapList list;
-	for (auto d:distances) {
-		list.push_back({
-			{"ClassType", "Distances"},
-			{"Type", "distance"},
-			{"team1", std::to_string(d.first.first->getId())},
-			{"team2", std::to_string(d.first.second->getId())},
-			{"dist", std::to_string(d.second)}
-			});		
-	}
-	return list;
-}
-AttrMapList Instance::serializeCOEWeights(){
-	AttrMapList list;
-	for (auto w:COEWeights) {
-		list.push_back({
-			{"ClassType", "COEWeights"},
-			{"Type", "COEWeight"},
-			{"team1", std::to_string(w.first.first->getId())},
-			{"team2", std::to_string(w.first.second->getId())},
-			{"weight", std::to_string(w.second)}
-			});		
-	}
-	return list;
-}
-AttrMapList Instance::serializeCosts(){
-	AttrMapList list;
-	for (auto c:costs) {
-		list.push_back({
-			{"ClassType", "Costs"},
-			{"Type", "cost"},
-			{"team1", std::to_string(std::get<0>(c.first)->getId())},
-			{"team2", std::to_string(std::get<1>(c.first)->getId())},
-			{"slot", std::to_string(std::get<2>(c.first)->getId())},
-			{"cost", std::to_string(c.second)}
-			});		
-	}
-	return list;
-}
 // Querry games
+// The scans are templated on the home mode, such that the mode is tested once per query instead of per meeting
+template <HomeMode mode>
+static void scanTeam(MeetingStore& meetings, const TeamSet& teams, MeetingList& foundMeetings){
+	const ScheduleState& st = meetings.getState();
+	const int nrMeetings = meetings.size();
+	for (int i = 0; i < nrMeetings; ++i) {
+		if (st.slot[i] == NULL) { continue; }
+		if (mode != A && teams.count(st.first[i])) { foundMeetings.push_back(meetings.get(i)); }
+		if (mode != H && teams.count(st.second[i])) { foundMeetings.push_back(meetings.get(i)); }
+	}
+}
+
+template <HomeMode mode>
+static void scanTeamSlot(MeetingStore& meetings, const TeamSet& teams, const SlotSet& slots, MeetingList& foundMeetings){
+	const ScheduleState& st = meetings.getState();
+	const int nrMeetings = meetings.size();
+	for (int i = 0; i < nrMeetings; ++i) {
+		Slot* s = st.slot[i];
+		if (s == NULL || !slots.count(s)) { continue; }
+		if (mode != A && teams.count(st.first[i])) { foundMeetings.push_back(meetings.get(i)); }
+		if (mode != H && teams.count(st.second[i])) { foundMeetings.push_back(meetings.get(i)); }
+	}
+}
+
+// Meetings with a home team from teams1 and an away team from teams2 (H), the reverse (A), or either (HA), in the slots
+// if slots is not NULL
+template <HomeMode mode>
+static void scanTeamTeam(MeetingStore& meetings, const TeamSet& teams1, const TeamSet& teams2, const SlotSet* slots, MeetingList& foundMeetings){
+	const ScheduleState& st = meetings.getState();
+	const int nrMeetings = meetings.size();
+	for (int i = 0; i < nrMeetings; ++i) {
+		Slot* s = st.slot[i];
+		if (s == NULL || (slots && !slots->count(s))) { continue; }
+		Team* t1 = st.first[i];
+		Team* t2 = st.second[i];
+		if ((mode != A && teams1.count(t1) && teams2.count(t2)) || (mode != H && teams1.count(t2) && teams2.count(t1))) {
+			foundMeetings.push_back(meetings.get(i));
+		}
+	}
+}
+
 MeetingList Instance::getMeetingsTeam(TeamSet teams, HomeMode mode){
 	// Return all scheduled home (H), away (HA), all (HA) meetings of teams in the team set
 	MeetingList foundMeetings {};
-	
-	for(auto meeting:meetings){
-		if (meeting->getAssignedSlot() == NULL) { continue; }
-		Team* t1 = meeting->getFirstTeam();
-		Team* t2 = meeting->getSecondTeam();
-		
-		if (teams.count(t1) && (mode == H || mode == HA) && meeting->getAssignedSlot() != NULL) {
-			foundMeetings.push_back(meeting);	
-		}
-	
-		if (teams.count(t2) && (mode == A || mode == HA) && meeting->getAssignedSlot() != NULL) {
-			foundMeetings.push_back(meeting);	
-		}	
-	}	
+	switch (mode) {
+		case H:	scanTeam<H>(meetings, teams, foundMeetings); break;
+		case A:	scanTeam<A>(meetings, teams, foundMeetings); break;
+		default: scanTeam<HA>(meetings, teams, foundMeetings); break;
+	}
+	countQuery(QueryStats::TEAM, meetings.size(), foundMeetings.size());
 	return foundMeetings;
 }
 
@@ -272,36 +289,29 @@ MeetingList Instance::getMeetingsSlot(SlotSet slots){
 	// Return all meetings scheduled in slots of the slot set
 	MeetingList foundMeetings {};
 
-	for(auto meeting:meetings){
-		if (meeting->getAssignedSlot() == NULL) { continue; }
-		Slot* s =  meeting->getAssignedSlot();
+	const ScheduleState& st = meetings.getState();
+	const int nrMeetings = meetings.size();
+	for (int i = 0; i < nrMeetings; ++i) {
+		Slot* s = st.slot[i];
+		if (s == NULL) { continue; }
 		if (slots.count(s)) {
-			foundMeetings.push_back(meeting);
+			foundMeetings.push_back(meetings.get(i));
 		}
 	}
 
+	countQuery(QueryStats::SLOT, nrMeetings, foundMeetings.size());
 	return foundMeetings;
 }
 
 MeetingList Instance::getMeetingsTeamSlot(TeamSet teams, SlotSet slots, HomeMode mode){
 	// Return all meetings of teams in the team set, scheduled in the slot set
 	MeetingList foundMeetings {};
-	
-	for (auto meeting:meetings){
-		if (meeting->getAssignedSlot() == NULL) { continue; }
-		Team* t1 = meeting->getFirstTeam();
-		Team* t2 = meeting->getSecondTeam();
-		Slot* s = meeting->getAssignedSlot();
-
-		if (slots.count(s) && teams.count(t1) && (mode == H || mode == HA) && meeting->getAssignedSlot() != NULL) {
-			foundMeetings.push_back(meeting);	
-		}
-	
-		if (slots.count(s) && teams.count(t2) && (mode == A || mode == HA) && meeting->getAssignedSlot() != NULL) {
-			foundMeetings.push_back(meeting);	
-		}
+	switch (mode) {
+		case H:	scanTeamSlot<H>(meetings, teams, slots, foundMeetings); break;
+		case A:	scanTeamSlot<A>(meetings, teams, slots, foundMeetings); break;
+		default: scanTeamSlot<HA>(meetings, teams, slots, foundMeetings); break;
 	}
-
+	countQuery(QueryStats::TEAMSLOT, meetings.size(), foundMeetings.size());
 	return foundMeetings;
 }
 
@@ -320,43 +330,35 @@ MeetingList Instance::getMeetingsTeamSlotGroup(TeamSet teams, SlotGroupSet slotG
 MeetingList Instance::getMeetingsTeamTeamSlot(TeamSet teams1, TeamSet teams2, SlotSet slots, HomeMode mode) {
 	// Return all meetings involving a (home) team from teams1 and an (away) team from teams2 during slots in slot set
 	MeetingList foundMeetings {};
-	
-	for(auto meeting:meetings){
-		if (meeting->getAssignedSlot() == NULL) { continue; }
-		Team* t1 = meeting->getFirstTeam();
-		Team* t2 = meeting->getSecondTeam();
-		Slot* s = meeting->getAssignedSlot();
-
-		if (slots.count(s) && (( mode != A && (teams1.count(t1) && teams2.count(t2))) || ( mode != H && (teams1.count(t2) && teams2.count(t1))))) {
-			foundMeetings.push_back(meeting);
-		}
+	switch (mode) {
+		case H:	scanTeamTeam<H>(meetings, teams1, teams2, &slots, foundMeetings); break;
+		case A:	scanTeamTeam<A>(meetings, teams1, teams2, &slots, foundMeetings); break;
+		default: scanTeamTeam<HA>(meetings, teams1, teams2, &slots, foundMeetings); break;
 	}
+	countQuery(QueryStats::TEAMTEAMSLOT, meetings.size(), foundMeetings.size());
 	return foundMeetings;
 }
 MeetingList Instance::getMeetingsTeamTeam(TeamSet teams1, TeamSet teams2, HomeMode mode) {
 	// Return all meetings involving a (home) team from teams1 and an (away) team from teams2
 	MeetingList foundMeetings {};
-	
-	for(auto meeting:meetings){
-		if (meeting->getAssignedSlot() == NULL) { continue; }
-		Team* t1 = meeting->getFirstTeam();
-		Team* t2 = meeting->getSecondTeam();
-		Slot* s = meeting->getAssignedSlot();
-
-		if (( mode != A && (teams1.count(t1) && teams2.count(t2))) || ( mode != H && (teams1.count(t2) && teams2.count(t1)))) {
-			foundMeetings.push_back(meeting);
-		}
+	switch (mode) {
+		case H:	scanTeamTeam<H>(meetings, teams1, teams2, NULL, foundMeetings); break;
+		case A:	scanTeamTeam<A>(meetings, teams1, teams2, NULL, foundMeetings); break;
+		default: scanTeamTeam<HA>(meetings, teams1, teams2, NULL, foundMeetings); break;
 	}
+	countQuery(QueryStats::TEAMTEAM, meetings.size(), foundMeetings.size());
 	return foundMeetings;
 }
 
 void Instance::addMeeting(Team* t1, Team* t2, bool noHome, int slot){ 
 	// noHome is true if the home advantage is undetermined. Otherwise it is assumed that t1 is the home 
 	// team and t2 is the away team
-	meetings.push_back(new Meeting(t1,t2,noHome, slot)); 
+	meetings.add(t1, t2, noHome, (slot >= 0) ? getSlot(slot) : NULL);
+	modelVersion = ScheduleState::nextVersion();
 	return;
 }
 void Instance::generateMeeting(League* l){
+	Profiler::Phase phase("meeting generation");
 	// Generate k round robin between all members of league
 	// Round robin even: teams meet each other k/2 times at each other venue
 	try{
@@ -387,31 +389,41 @@ void Instance::scheduleMeeting(Team* h, Team* a, Slot* s){
 	// Find unscheduled meeting between home team h, and away team a
 	// By preference, select meeting with determined home advantage
 	try{
-		Meeting* m = NULL;
+		int m = -1;
 		
-		for(auto meeting:meetings){
-			if (meeting->getAssignedSlot() != NULL) { continue; }
-			Team* t1 = meeting->getFirstTeam();
-			Team* t2 = meeting->getSecondTeam();
+		const int nrMeetings = meetings.size();
+		for (int i = 0; i < nrMeetings; ++i) {
+			if (meetings.getAssignedSlot(i) != NULL) { continue; }
+			Team* t1 = meetings.getFirstTeam(i);
+			Team* t2 = meetings.getSecondTeam(i);
 			
 			// Case 1: teams match + determined home advantage	
-			if (t1 == h && t2 == a && !meeting->getNoHome()) { m = meeting; break; }
+			if (t1 == h && t2 == a && !meetings.getNoHome(i)) { m = i; break; }
 			// Case 2: teams match + undetermined home advantage
-			if (t1 == h && t2 == a && meeting->getNoHome()) { m = meeting; }
-			if (t1 == a && t2 == h && meeting->getNoHome()) { m = meeting; m->swapTeams();  }
+			if (t1 == h && t2 == a && meetings.getNoHome(i)) { m = i; }
+			if (t1 == a && t2 == h && meetings.getNoHome(i)) { m = i; meetings.swapTeams(i);  }
 		}
-		if (m == NULL) { 
+		if (m == -1) { 
 			std::stringstream msg;
 			msg << "Meeting not scheduled: there is no unscheduled meeting between home team " << h->getId() << " (" << h->getName() << ")" << " and away team " << a->getId() << " (" << a->getName() << ")" <<  std::endl;
 			throw_line_robinx(XmlReadingException, msg.str());
 		}
-		m->setAssignedSlot(s);
+		meetings.setAssignedSlot(m, s);
 	} catch(XmlReadingException e){
 		std::cerr << e.what() << std::endl;
 	}
 }
 
 int Instance::carryOver(League* l){
+	// Evaluate on the packed schedule, fall back to the meeting lists if it is not valid or data is missing
+	const PackedSchedule& ps = getPackedSchedule();
+	if (ps.isValid()) {
+		std::vector<int> members;
+		for (auto t : l->getMembers()) { members.push_back(t->getId()); }
+		int value;
+		if (ps.carryOver(members, getCOEWeightTable(), value)) { return value; }
+	}
+
 	// Step 0: create a carry-over effects matrix on the heap
 	int nrRows = l->getNrMembers();
 	int** COM = new int*[nrRows];
@@ -464,6 +476,13 @@ int Instance::carryOver(League* l){
 }
 
 int Instance::distance(Team* t, SlotSet slots){
+	const PackedSchedule& ps = getPackedSchedule();
+	if (ps.isValid()) {
+		const SlotMask mask = ps.slotMask(slots);
+		int value;
+		if (ps.distance(t->getId(), getDistanceTable(), slots.empty() ? NULL : mask.data(), value)) { return value; }
+	}
+
 	int dist = 0;
 	// Get list with all matches of t
 	MeetingList meetings = getMeetingsTeam({t}, HA);		
@@ -491,6 +510,9 @@ int Instance::distance(Team* t, SlotSet slots){
 }
 
 int Instance::breaks(Team* t){
+	const PackedSchedule& ps = getPackedSchedule();
+	if (ps.isValid()) { return ps.breaks(t->getId()); }
+
 	int br = 0;
 	// Get all the games of the team
 	MeetingList meetings = getMeetingsTeam({t}, HA);
@@ -508,6 +530,10 @@ int Instance::breaks(Team* t){
 }
 
 int Instance::cost(Team* t){
+	const PackedSchedule& ps = getPackedSchedule();
+	int value;
+	if (ps.isValid() && ps.cost(t->getId(), getCostTable(), value)) { return value; }
+
 	int cost = 0;
 	// Get all the home games of the team
 	MeetingList meetings = getMeetingsTeam({t}, H);
@@ -521,6 +547,7 @@ int Instance::cost(Team* t){
 }
 
 void Instance::checkConstr(bool silent){
+	Tracer::Span span("checkConstr", "validation");
 	// Disable cout
 	if (silent) {
 		std::cout.setstate(std::ios_base::failbit);
@@ -530,7 +557,262 @@ void Instance::checkConstr(bool silent){
 	std::pair<int, int> temp; // Dummy to add two pairs
 
 	// Base constraints
+	checkBase(result);
+
+	// Symmetry
+	checkSymmetry(result);
+	ObjCost fixed = result;
+
+	for (auto c:constraints) {
+		temp = evaluate(c);
+		result.first += temp.first;
+		result.second += temp.second;
+	}
+
+	// Calculate objective value
+	{
+		Profiler::Phase phase("objective");
+		int cost = calculateObj();
+		result.second += cost;
+		fixed.second += cost;
+	}
+	ScheduleCache& cache = meetings.getCache();
+	cache.fixedCost = fixed;
+	cache.fixedVersion = getFixedVersion();
+
+	try {
+		if (objectiveValue.first != -1 && objectiveValue.first != result.first) {
+			throw_line_robinx(XmlValidationException, "Infeasibility value of " + std::to_string(result.first) +  " does not correspond with value from XML file (" + std::to_string(objectiveValue.first) + ").");
+		}
+	}catch(XmlValidationException e) {
+		std::cerr << e.what() << std::endl;	
+	}
+
+	try {
+		if (objectiveValue.second != -1 && objectiveValue.second != result.second) {
+			throw_line_robinx(XmlValidationException, "Objective value of " + std::to_string(result.second) + " does not correspond with value from XML file (" + std::to_string(objectiveValue.second) + ").");
+		}		
+	}catch(XmlValidationException e) {
+		std::cerr << e.what() << std::endl;	
+	}	
+	try {
+		if (lowerBound.first != -1 && lowerBound.first > result.first) {
+			throw_line_robinx(XmlValidationException, "Infeasibility value of " + std::to_string(result.first) +  " is lower than infeasibility lowerbound from XML file (" + std::to_string(objectiveValue.first) + ").");
+		}
+	}catch(XmlValidationException e) {
+		std::cerr << e.what() << std::endl;	
+	}
+
+	try {
+		if (lowerBound.second != -1 && lowerBound.second > result.second) {
+			throw_line_robinx(XmlValidationException, "Objective value of " + std::to_string(result.second) + " is lower than objective value lowerbound from XML file (" + std::to_string(objectiveValue.second) + ").");
+		}		
+	}catch(XmlValidationException e) {
+		std::cerr << e.what() << std::endl;	
+	}
+
+	objectiveValue = result;
+
+	// Enable cout again
+	if(silent){
+		std::cout.clear();
+	}
+	return;
+}
+
+bool Instance::checkConstrBounded(const ObjCost bound, bool silent){
+	Tracer::Span span("checkConstrBounded", "validation");
+	if (silent) {
+		std::cout.setstate(std::ios_base::failbit);
+	}
+	auto exceeds = [bound](const ObjCost cost) {
+		if (bound.first == -1) { return bound.second != -1 && cost.second > bound.second; }
+		if (bound.second == -1) { return cost.first > bound.first; }
+		return cost.first > bound.first || (cost.first == bound.first && cost.second > bound.second);
+	};
+
+	// The objective can be negative, and is calculated first if it is bounded. All constraints add a non-negative cost,
+	// such that the running cost can only increase.
+	ObjCost result = std::make_pair(0,0);
+	if (bound.second != -1) {
+		Profiler::Phase phase("objective");
+		result.second += calculateObj();
+	}
+
+	// Base constraints, as in checkConstr, and all other constraints
+	BA1 base1(HARD, 1);
+	BA2 base2(HARD, 2);
+	std::vector<Constraint*> order;
+	bool found = false;
+	for (auto c:constraints) {
+		if (c->getName().compare("BA1")==0) { found = true; }
+	}
+	if (!found) { order.push_back(&base1); }
+	order.push_back(&base2);
+	order.push_back(NULL); 		// Stands for the symmetry check
+	for (auto c:constraints) { order.push_back(c); }
+
+	// Cheap and frequently violated constraint types first, hard constraints before soft ones
+	std::vector<double> priority;
+	for (auto c:order) { priority.push_back(c ? getPriority(c->getName(), c->getType()) : getPriority("symmetry", HARD)); }
+	std::vector<int> index(order.size());
+	std::iota(index.begin(), index.end(), 0);
+	std::stable_sort(index.begin(), index.end(), [&order, &priority](const int i, const int j) {
+		const bool hard1 = !order[i] || order[i]->getType() == HARD;
+		const bool hard2 = !order[j] || order[j]->getType() == HARD;
+		if (hard1 != hard2) { return hard1; }
+		return priority[i] > priority[j];
+	});
+
+	bool exceeded = false;
+	for (auto i:index) {
+		Constraint* c = order[i];
+		const Profiler::Clock::time_point start = Profiler::Clock::now();
+		ObjCost cost = std::make_pair(0,0);
+		if (c) {
+			cost = evaluate(c);
+		} else {
+			checkSymmetry(cost);
+		}
+		TypeStats& stats = c ? typeStats[std::make_pair(c->getName(), c->getType())] : typeStats[std::make_pair(std::string("symmetry"), HARD)];
+		stats.calls++;
+		stats.violations += (cost.first != 0 || cost.second != 0);
+		stats.seconds += Profiler::elapsed(start);
+
+		result.first += cost.first;
+		result.second += cost.second;
+		if (exceeds(result)) {
+			exceeded = true;
+			break;
+		}
+	}
+
+	if (!exceeded && bound.second == -1) {
+		Profiler::Phase phase("objective");
+		result.second += calculateObj();
+		exceeded = exceeds(result);
+	}
+	objectiveValue = result;
+
+	if (silent) {
+		std::cout.clear();
+	}
+	return !exceeded;
+}
+
+ObjCost Instance::reweigh(){
+	Tracer::Span span("reweigh", "validation");
+	std::cout.setstate(std::ios_base::failbit);
+	ObjCost result = scheduleCost();
+	std::cout.clear();
+	return result;
+}
+
+ObjCost Instance::scheduleCost(){
+	if (meetings.getCache().fixedVersion != getFixedVersion()) {
+		ObjCost fixed = std::make_pair(0,0);
+		checkBase(fixed);
+		checkSymmetry(fixed);
+		Profiler::Phase phase("objective");
+		fixed.second += calculateObj();
+		ScheduleCache& cache = meetings.getCache();
+		cache.fixedCost = fixed;
+		cache.fixedVersion = getFixedVersion();
+	}
+
+	// The deviations of constraints checked on this schedule only need to be weighed again
+	ObjCost result = meetings.getCache().fixedCost;
+	for (auto c:constraints) {
+		int dev = getDeviation(c);
+		if (dev == -1) {
+			evaluate(c);
+			dev = getDeviation(c);
+		}
+		ObjCost cost = c->weigh(dev);
+		result.first += cost.first;
+		result.second += cost.second;
+	}
+	return result;
+}
+
+int Instance::getDeviation(const Constraint* c) const{
+	const ScheduleCache& cache = meetings.getCache();
+	auto it = cache.deviations.find(c);
+	return (it != cache.deviations.end() && it->second.second == getDeviationVersion()) ? it->second.first : -1;
+}
+
+void Instance::freeze(){
+	Tracer::Span span("freeze", "validation");
+	indexGroups();
+	getDistanceTable();
+	getCOEWeightTable();
+	getCostTable();
+	getPackedSchedule();
+	batchConstraints();
+
+	// The constraints, including the base constraints and the symmetry check, intern their teams and slots when they
+	// are checked
+	std::cout.setstate(std::ios_base::failbit);
+	scheduleCost();
+	std::cout.clear();
+}
+
+std::vector<ObjCost> Instance::evaluateSchedules(const std::vector<std::shared_ptr<ScheduleState>>& schedules, const int nrThreads){
+	Tracer::Span span("evaluateSchedules", "validation");
+	freeze();
+	const bool statistics = Profiler::get()->isEnabled() || Tracer::get()->isEnabled();
+	const int nrWorkers = statistics ? 1 : std::max(1, std::min(nrThreads, (int) schedules.size()));
+
+	// A state may only be evaluated by one thread at a time: a schedule that is listed more than once is evaluated once
+	std::vector<size_t> distinct;
+	std::vector<size_t> first(schedules.size());
+	std::map<const ScheduleState*, size_t> seen;
+	for (size_t i = 0; i < schedules.size(); ++i) {
+		auto it = seen.insert(std::make_pair(schedules[i].get(), i)).first;
+		if (it->second == i) { distinct.push_back(i); }
+		first[i] = it->second;
+	}
+
+	// Every worker takes the next schedule, and binds it to its thread. The meetings are only read, and the cache is
+	// written to the schedule in the list, such that the caller can reweigh it without checking it again.
+	std::vector<ObjCost> costs(schedules.size());
+	std::atomic<size_t> next(0);
+	auto work = [this, &schedules, &distinct, &costs, &next]() {
+		quietReport = true;
+		for (size_t k = next++; k < distinct.size(); k = next++) {
+			bindSchedule(schedules[distinct[k]]);
+			costs[distinct[k]] = scheduleCost();
+		}
+		bindSchedule(NULL);
+		quietReport = false;
+	};
+
+	std::vector<std::thread> workers;
+	for (int w = 1; w < nrWorkers; ++w) { workers.push_back(std::thread(work)); }
+	work();
+	for (auto& w : workers) { w.join(); }
+	for (size_t i = 0; i < schedules.size(); ++i) { costs[i] = costs[first[i]]; }
+	return costs;
+}
+
+std::ostream& Instance::report(){
+	// Setting the width of cout is not thread-safe: quiet threads write to a stream of their own without buffer
+	static thread_local std::ostream discard(NULL);
+	return quietReport ? discard : std::cout;
+}
+
+double Instance::getPriority(const std::string name, const CType type) const{
+	// Types that were not evaluated yet count as violated half of the time, in a microsecond
+	auto it = typeStats.find(std::make_pair(name, type));
+	if (it == typeStats.end() || it->second.calls == 0) { return 0.5/1e-6; }
+	const TypeStats& stats = it->second;
+	const double rate = (stats.violations + 1.0)/(stats.calls + 2.0);
+	return rate/std::max(stats.seconds/stats.calls, 1e-9);
+}
+
+void Instance::checkBase(ObjCost& result){
 	// Check whether it is mandatory to schedule all games
+	ObjCost temp;
 	bool found = false;
 	for (auto c:constraints) {
 		if (c->getName().compare("BA1")==0) {
@@ -540,19 +822,20 @@ void Instance::checkConstr(bool silent){
 		}
 	}
 	if (!found) {
-		BA1 base1 = BA1(HARD, 1);
-		temp = base1.checkConstr();
+		temp = evaluate(baseGames);
 		result.first += temp.first;
 		result.second += temp.second;
 	} 
 
-	BA2 base2 = BA2(HARD, 2);
-	temp = base2.checkConstr();
+	temp = evaluate(baseSlots);
 	result.first += temp.first;
 	result.second += temp.second;
+}
 
-	// Symmetry
+void Instance::checkSymmetry(ObjCost& result){
+	// Every violated symmetry adds one to the infeasibility
 	try{
+		Profiler::Phase phase("symmetry");
 		for (auto l:getLeagues()) {
 			const int nrRoundRobin = l.second->getNrRound();
 			const int nrTeams = l.second->getNrMembers();
@@ -581,7 +864,7 @@ void Instance::checkConstr(bool silent){
 										result.first += 1;
 										std::stringstream msg;
 										msg << "Game (" <<  t1->getId() << "," << t2->getId() << ") on slot " << s+r*nrSlotsPhase << " and game (" <<  t2->getId() << "," << t1->getId() << ") on slot " << s + (r+1)*nrSlotsPhase;
-										std::cout << std::setw(10) << "Mirror violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
+										report() << std::setw(10) << "Mirror violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
 									}
 								}
 								break;
@@ -601,7 +884,7 @@ void Instance::checkConstr(bool silent){
 										result.first += 1;
 										std::stringstream msg;
 										msg << "Game (" <<  t1->getId() << "," << t2->getId() << ") on slot " << s+r*nrSlotsPhase << " and game (" <<  t2->getId() << "," << t1->getId() << ") on slot " << s + (r+1)*nrSlotsPhase;
-										std::cout << std::setw(10) << "English violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
+										report() << std::setw(10) << "English violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
 									}
 								}
 								break;
@@ -621,7 +904,7 @@ void Instance::checkConstr(bool silent){
 										result.first += 1;
 										std::stringstream msg;
 										msg << "Game (" <<  t1->getId() << "," << t2->getId() << ") on slot " << s+r*nrSlotsPhase << " and game (" <<  t2->getId() << "," << t1->getId() << ") on slot " << s + (r+1)*nrSlotsPhase;
-										std::cout << std::setw(10) << "French violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
+										report() << std::setw(10) << "French violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
 									}
 								}
 								break;
@@ -635,7 +918,7 @@ void Instance::checkConstr(bool silent){
 										result.first += 1;
 										std::stringstream msg;
 										msg << "Game (" <<  t1->getId() << "," << t2->getId() << ") on slot " << s+r*nrSlotsPhase << " and game (" <<  t2->getId() << "," << t1->getId() << ") on slot " << s + (r+1)*nrSlotsPhase;
-										std::cout << std::setw(10) << "Inverted violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
+										report() << std::setw(10) << "Inverted violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
 									}
 								}
 								break;
@@ -652,7 +935,7 @@ void Instance::checkConstr(bool silent){
 									result.first += 1;
 										std::stringstream msg;
 										msg << "Team " << t1->getId() << " and team " << t2->getId() << " meet " << meetings.size() << " times in phase " << r << " of the tournament. Should be 1.";
-										std::cout << std::setw(10) << "Phased violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
+										report() << std::setw(10) << "Phased violation." << std::setw(10) << "" << std::setw(50) << msg.str() << std::setw(10) << result.first << std::setw(10) << result.second << std::endl;
 								}
 								break;
 							}
@@ -664,55 +947,83 @@ void Instance::checkConstr(bool silent){
 	}catch(XmlValidationException e) {
 		std::cerr << e.what() << std::endl;	
 	}
+}
 
-	for (auto c:constraints) {
-		temp = c->checkConstr();
-		result.first += temp.first;
-		result.second += temp.second;
-	}
+ObjCost Instance::evaluate(Constraint* c){
+	// Attribute the meeting queries of this thread to the constraint
+	auto it = constraintQueries.find(c);
+	currentQueries = (it != constraintQueries.end()) ? &it->second : NULL;
 
-	// Calculate objective value
-	int cost = calculateObj();
-	result.second += cost;
+	Constraint::deviation = 0;
 
-	try {
-		if (objectiveValue.first != -1 && objectiveValue.first != result.first) {
-			throw_line_robinx(XmlValidationException, "Infeasibility value of " + std::to_string(result.first) +  " does not correspond with value from XML file (" + std::to_string(objectiveValue.first) + ").");
+	ObjCost cost;
+	Profiler* profiler = Profiler::get();
+	if (!profiler->isEnabled() && !Tracer::get()->isEnabled()) {
+		cost = c->checkConstr();
+	} else {
+		Tracer::Span span(c->getName(), "constraint");
+		const unsigned long scanned = getNrMeetingsScanned();
+		const Profiler::Clock::time_point start = Profiler::Clock::now();
+		cost = c->checkConstr();
+		if (profiler->isEnabled()) {
+			profiler->addConstraint(c, Profiler::elapsed(start), cost, getNrMeetingsScanned() - scanned);
 		}
-	}catch(XmlValidationException e) {
-		std::cerr << e.what() << std::endl;	
 	}
+	currentQueries = NULL;
 
-	try {
-		if (objectiveValue.second != -1 && objectiveValue.second != result.second) {
-			throw_line_robinx(XmlValidationException, "Objective value of " + std::to_string(result.second) + " does not correspond with value from XML file (" + std::to_string(objectiveValue.second) + ").");
-		}		
-	}catch(XmlValidationException e) {
-		std::cerr << e.what() << std::endl;	
-	}	
-	try {
-		if (lowerBound.first != -1 && lowerBound.first > result.first) {
-			throw_line_robinx(XmlValidationException, "Infeasibility value of " + std::to_string(result.first) +  " is lower than infeasibility lowerbound from XML file (" + std::to_string(objectiveValue.first) + ").");
-		}
-	}catch(XmlValidationException e) {
-		std::cerr << e.what() << std::endl;	
+	// Keep the deviation of the constraints in the list, for reweigh
+	if (it != constraintQueries.end()) {
+		meetings.getCache().deviations[c] = std::make_pair(Constraint::deviation, getDeviationVersion());
 	}
+	return cost;
+}
 
-	try {
-		if (lowerBound.second != -1 && lowerBound.second > result.second) {
-			throw_line_robinx(XmlValidationException, "Objective value of " + std::to_string(result.second) + " is lower than objective value lowerbound from XML file (" + std::to_string(objectiveValue.second) + ").");
-		}		
-	}catch(XmlValidationException e) {
-		std::cerr << e.what() << std::endl;	
-	}
+void Instance::countQuery(const QueryStats::Query q, const unsigned long visited, const unsigned long returned){
+	queryStats.add(q, visited, returned);
+	(currentQueries ? currentQueries : &otherQueries)->add(q, visited, returned);
+}
 
-	objectiveValue = result;
+const QueryStats& Instance::getQueryStats(const Constraint* c) const{
+	auto it = constraintQueries.find(c);
+	return (it != constraintQueries.end()) ? it->second : otherQueries;
+}
 
-	// Enable cout again
-	if(silent){
-		std::cout.clear();
+void Instance::clearQueryStats(){
+	queryStats.clear();
+	otherQueries.clear();
+	for (auto& c : constraintQueries) { c.second.clear(); }
+}
+
+void Instance::printQueryStats(std::ostream& out) const{
+	const std::string line = "       -------------------------------------------------------------------";
+	out << std::left << std::setw(20) << "       Caller" << std::setw(26) << "Query" << std::setw(10) << "Calls" << std::setw(12) << "Visited" << "Returned" << std::right << std::endl;
+	queryStats.print(out, "Total");
+	out << line << std::endl;
+
+	// Constraints numbered by their position in the instance file
+	int i = 0;
+	for (auto c : constraints) {
+		getQueryStats(c).print(out, c->getName() + " #" + std::to_string(i));
+		i++;
 	}
-	return;
+	otherQueries.print(out, "Other");
+	out << line << std::endl;
+}
+
+void Instance::printQueryStatsJson(std::ostream& out) const{
+	out << "{\n  \"total\": ";
+	queryStats.printJson(out);
+	out << ",\n  \"other\": ";
+	otherQueries.printJson(out);
+	out << ",\n  \"constraints\": [";
+	int i = 0;
+	for (auto c : constraints) {
+		out << (i ? ",\n" : "\n") << "    {\"index\": " << i << ", \"name\": \"" << c->getName() << "\", \"queries\": ";
+		getQueryStats(c).printJson(out);
+		out << "}";
+		i++;
+	}
+	out << "\n  ]\n}" << std::endl;
 }
 
 int Instance::calculateObj(){
@@ -794,30 +1105,313 @@ void Instance::printSolution(){
 	}
 }
 
+// Union of the masks of groups, false if a group is not in the index
+template <typename G>
+static bool unionMasks(const GroupIndex<G>& index, const std::set<G*>& groups, std::vector<uint64_t>& mask){
+	for (auto g : groups) {
+		const uint64_t* row = index.getMask(g);
+		if (row == NULL) { return false; }
+		for (int w = 0; w < index.getNrWords(); ++w) { mask[w] |= row[w]; }
+	}
+	return true;
+}
+
 TeamSet Instance::collectTeams(TeamSet teams, TeamGroupSet teamGroups){
 	TeamSet set(teams);
+	if (teamGroups.empty()) { return set; }
+	indexGroups();
+	std::vector<uint64_t> mask(teamGroupMembers.getNrWords(), 0);
+	if (teamGroupMembers.isValid() && unionMasks(teamGroupMembers, teamGroups, mask)) {
+		// Insert every team of the union once
+		for (int w = 0; w < (int) mask.size(); ++w) {
+			for (uint64_t bits = mask[w]; bits; bits &= bits - 1) { set.insert(getTeam(w*64 + __builtin_ctzll(bits))); }
+		}
+		return set;
+	}
 	for (auto tg : teamGroups) { 
-		for (auto t : tg->getMembers()) { set.insert(t); }
+		for (TeamSetIt it = tg->getFirstMember(); it != tg->getLastMember(); ++it) { set.insert(*it); }
 	}
 	return set;	
 }
 SlotSet Instance::collectSlots(SlotSet slots, SlotGroupSet slotGroups){
 	SlotSet set(slots);
+	if (slotGroups.empty()) { return set; }
+	indexGroups();
+	std::vector<uint64_t> mask(slotGroupMembers.getNrWords(), 0);
+	if (slotGroupMembers.isValid() && unionMasks(slotGroupMembers, slotGroups, mask)) {
+		// Insert every slot of the union once
+		for (int w = 0; w < (int) mask.size(); ++w) {
+			for (uint64_t bits = mask[w]; bits; bits &= bits - 1) { set.insert(getSlot(w*64 + __builtin_ctzll(bits))); }
+		}
+		return set;
+	}
 	for (auto sg : slotGroups) { 
-		for (auto s : sg->getMembers()) { set.insert(s); }
+		for (SlotSetIt it = sg->getFirstMember(); it != sg->getLastMember(); ++it) { set.insert(*it); }
 	}
 	return set;
 }
+SlotMask Instance::collectSlotMask(const SlotSet& slots, const SlotGroupSet& slotGroups){
+	indexGroups();
+	SlotMask mask(slotGroupMembers.getNrWords(), 0);
+	if (!slotGroupMembers.isValid() || !unionMasks(slotGroupMembers, slotGroups, mask)) {
+		return getPackedSchedule().slotMask(collectSlots(slots, slotGroups));
+	}
+	const int nrSlots = getNrSlots();
+	for (auto s : slots) {
+		const int id = s->getId();
+		if (id >= 0 && id < nrSlots) { mask[id/64] |= (uint64_t) 1 << (id%64); }
+	}
+	return mask;
+}
+
+// Hash of a union of entities and groups, independent of the order of the sets
+template <typename E, typename G>
+static uint64_t setHash(const std::set<E*>& entities, const std::set<G*>& groups){
+	auto mix = [](uint64_t x) {
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	};
+	uint64_t hash = entities.size();
+	for (auto e : entities) { hash += mix(2*(uint64_t) e->getId()); }
+	for (auto g : groups) { hash += mix(2*(uint64_t) g->getId() + 1); }
+	return hash;
+}
+
+const TeamSet& Instance::internTeams(const TeamSet& teams, const TeamGroupSet& teamGroups){
+	indexGroups();
+	const uint64_t hash = setHash(teams, teamGroups);
+	auto range = teamSetIds.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it) {
+		const InternedTeams& interned = internedTeams[it->second];
+		if (interned.teams == teams && interned.teamGroups == teamGroups) { return interned.all; }
+	}
+	teamSetIds.insert(std::make_pair(hash, (int) internedTeams.size()));
+	internedTeams.push_back(InternedTeams());
+	internedTeams.back().teams = teams;
+	internedTeams.back().teamGroups = teamGroups;
+	internedTeams.back().all = collectTeams(teams, teamGroups);
+	return internedTeams.back().all;
+}
+
+int Instance::internSlots(const SlotSet& slots, const SlotGroupSet& slotGroups){
+	indexGroups();
+	const uint64_t hash = setHash(slots, slotGroups);
+	auto range = slotSetIds.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it) {
+		const InternedSlots& interned = internedSlots[it->second];
+		if (interned.slots == slots && interned.slotGroups == slotGroups) { return it->second; }
+	}
+	const int id = internedSlots.size();
+	slotSetIds.insert(std::make_pair(hash, id));
+	internedSlots.push_back(InternedSlots());
+	internedSlots.back().slots = slots;
+	internedSlots.back().slotGroups = slotGroups;
+	internedSlots.back().all = collectSlots(slots, slotGroups);
+
+	// Split the union in ranges of consecutive ids
+	std::vector<int> ids;
+	for (auto s : internedSlots.back().all) { ids.push_back(s->getId()); }
+	std::sort(ids.begin(), ids.end());
+	std::vector<std::pair<int, int>>& ranges = internedSlots.back().ranges;
+	for (auto s : ids) {
+		if (!ranges.empty() && ranges.back().second == s - 1) {
+			ranges.back().second = s;
+		} else {
+			ranges.push_back(std::make_pair(s, s));
+		}
+	}
+	return id;
+}
+
+int Instance::nrGames(Team* t, const int slotsId, const HomeMode mode){
+	const InternedSlots& interned = internedSlots[slotsId];
+	const PackedSchedule& ps = getPackedSchedule();
+	if (!ps.isValid()) {
+		return getMeetingsTeamSlot({t}, interned.all, mode).size();
+	}
+	int nr = 0;
+	for (auto r : interned.ranges) { nr += ps.nrGames(t->getId(), mode, r.first, r.second); }
+	return nr;
+}
+
+void Instance::indexGroups(){
+	if (groupsIndexed) { return; }
+	teamSetIds.clear();
+	internedTeams.clear();
+	slotSetIds.clear();
+	internedSlots.clear();
+	teamGroupMembers.build(teamGroups, teams.size());
+	slotGroupMembers.build(slotGroups, slots.size());
+	groupsIndexed = true;
+	batchedVersion = -1;
+}
 
 
 void Instance::clearSchedule(){
-	MeetingList meetings = getMeetings();
-	for(auto m : meetings){
-		m->setAssignedSlot(NULL);
+	meetings.clearSlots();
+	return;
+}
+
+uint64_t Instance::getInstanceHash(){
+	if (!instanceHashed) {
+		instanceHash = hashFile(instanceFile);
+		instanceHashed = true;
+	}
+	return instanceHash;
+}
+
+void Instance::resetSolution(){
+	meetings.resetSchedule();
+	objectiveValue = std::make_pair(-1,-1);
+	solutionName = "NULL";
+	xmlSchemaSol = "NULL";
+	if (metaDataSaved) {
+		instanceName = savedMetaData.instanceName;
+		xmlSchemaIn = savedMetaData.xmlSchemaIn;
+		contributor = savedMetaData.contributor;
+		date = savedMetaData.date;
+		remarks = savedMetaData.remarks;
+		solMethod = savedMetaData.solMethod;
+		lowerBound = savedMetaData.lowerBound;
 	}
 	return;
 }
 
+void Instance::saveInstanceMetaData(){
+	savedMetaData.instanceName = instanceName;
+	savedMetaData.xmlSchemaIn = xmlSchemaIn;
+	savedMetaData.contributor = contributor;
+	savedMetaData.date = date;
+	savedMetaData.remarks = remarks;
+	savedMetaData.solMethod = solMethod;
+	savedMetaData.lowerBound = lowerBound;
+	metaDataSaved = true;
+}
+
+const PackedSchedule& Instance::getPackedSchedule(){
+	const unsigned long version = getScheduleVersion();
+	ScheduleCache& cache = meetings.getCache();
+	if (cache.packedVersion != version) {
+		cache.packed.build(meetings, teams, slots);
+		countQuery(QueryStats::PACKED, meetings.size(), 0);
+		cache.packedVersion = version;
+	}
+	return cache.packed;
+}
+
+void Instance::batchConstraints(){
+	indexGroups();
+	if (batchedVersion == constraintsVersion) { return; }
+	batches.clear();
+	batchMembers.clear();
+	batchedVersion = constraintsVersion;
+	batchesVersion = ScheduleState::nextVersion();
+
+	// The batches index the teams and slots by id, as the packed schedule
+	const int nrTeams = teams.size();
+	const int nrSlots = slots.size();
+	if ((nrTeams && (teams.begin()->first != 0 || teams.rbegin()->first != nrTeams - 1))
+		|| (nrSlots && (slots.begin()->first != 0 || slots.rbegin()->first != nrSlots - 1))) {
+		return;
+	}
+
+	// One batch per type and modes, its members in the order of the constraint list
+	std::map<std::pair<int, int>, int> batchIds;
+	for (auto c : constraints) {
+		ConstraintBatch::Kind kind;
+		HomeMode mode;
+		const TeamSet* teams1;
+		const TeamSet* teams2;
+		int slotsId;
+		if (CA2* con = dynamic_cast<CA2*>(c)) {
+			kind = (con->mode2 == GLOBAL) ? ConstraintBatch::CA2GLOBAL : ConstraintBatch::CA2EVERY;
+			mode = con->mode1;
+			teams1 = &internTeams(con->teams1, con->teamGroups1);
+			teams2 = &internTeams(con->teams2, con->teamGroups2);
+			slotsId = internSlots(con->slots, con->slotGroups);
+		} else if (CA4* con = dynamic_cast<CA4*>(c)) {
+			kind = ConstraintBatch::CA4ANY;
+			mode = con->mode1;
+			teams1 = &internTeams(con->teams1, con->teamGroups1);
+			teams2 = &internTeams(con->teams2, con->teamGroups2);
+			slotsId = internSlots(con->slots, con->slotGroups);
+		} else {
+			continue;
+		}
+		auto it = batchIds.insert(std::make_pair(std::make_pair((int) kind, (int) mode), (int) batches.size())).first;
+		if (it->second == (int) batches.size()) { batches.push_back(ConstraintBatch(kind, mode, nrTeams, nrSlots)); }
+		batchMembers[c] = std::make_pair(it->second, batches[it->second].add(c, *teams1, *teams2, getInternedSlots(slotsId)));
+	}
+	for (auto& b : batches) { b.finish(); }
+}
+
+const int* Instance::getBatchCounts(const Constraint* c){
+	batchConstraints();
+	auto it = batchMembers.find(c);
+	if (it == batchMembers.end() || !getPackedSchedule().isValid()) { return NULL; }
+	const int b = it->second.first;
+	const unsigned long version = std::max(getScheduleVersion(), batchesVersion);
+	ScheduleCache& cache = meetings.getCache();
+	if (cache.batchVersions.size() != batches.size()) {
+		cache.batchCounts.resize(batches.size());
+		cache.batchVersions.assign(batches.size(), -1);
+	}
+	if (cache.batchVersions[b] != version) {
+		batches[b].evaluate(cache.packed, cache.batchCounts[b]);
+		cache.batchVersions[b] = version;
+	}
+	return cache.batchCounts[b].data() + batches[b].getOffset(it->second.second);
+}
+
+const DenseTable& Instance::getDistanceTable(){
+	const int nrTeams = teams.size();
+	if (!distanceTable.built || (int) distanceTable.values.size() != nrTeams*nrTeams) {
+		distanceTable.values.assign(nrTeams*nrTeams, 0);
+		distanceTable.isSet.assign(nrTeams*nrTeams, false);
+		for (auto d : distances) {
+			const int t1 = d.first.first->getId(), t2 = d.first.second->getId();
+			if (t1 < 0 || t1 >= nrTeams || t2 < 0 || t2 >= nrTeams) { continue; }
+			distanceTable.values[t1*nrTeams + t2] = d.second;
+			distanceTable.isSet[t1*nrTeams + t2] = true;
+		}
+		distanceTable.built = true;
+	}
+	return distanceTable;
+}
+
+const DenseTable& Instance::getCOEWeightTable(){
+	const int nrTeams = teams.size();
+	if (!COEWeightTable.built || (int) COEWeightTable.values.size() != nrTeams*nrTeams) {
+		COEWeightTable.values.assign(nrTeams*nrTeams, 0);
+		COEWeightTable.isSet.assign(nrTeams*nrTeams, false);
+		for (auto w : COEWeights) {
+			const int t1 = w.first.first->getId(), t2 = w.first.second->getId();
+			if (t1 < 0 || t1 >= nrTeams || t2 < 0 || t2 >= nrTeams) { continue; }
+			COEWeightTable.values[t1*nrTeams + t2] = w.second;
+			COEWeightTable.isSet[t1*nrTeams + t2] = true;
+		}
+		COEWeightTable.built = true;
+	}
+	return COEWeightTable;
+}
+
+const DenseTable& Instance::getCostTable(){
+	const int nrTeams = teams.size(), nrSlots = slots.size();
+	if (!costTable.built || (int) costTable.values.size() != nrTeams*nrTeams*nrSlots) {
+		costTable.values.assign(nrTeams*nrTeams*nrSlots, 0);
+		costTable.isSet.assign(nrTeams*nrTeams*nrSlots, false);
+		for (auto c : costs) {
+			const int t1 = std::get<0>(c.first)->getId(), t2 = std::get<1>(c.first)->getId(), s = std::get<2>(c.first)->getId();
+			if (t1 < 0 || t1 >= nrTeams || t2 < 0 || t2 >= nrTeams || s < 0 || s >= nrSlots) { continue; }
+			costTable.values[(t1*nrTeams + t2)*nrSlots + s] = c.second;
+			costTable.isSet[(t1*nrTeams + t2)*nrSlots + s] = true;
+		}
+		costTable.built = true;
+	}
+	return costTable;
+}
+
 Team* Instance::getRandTeam(){
 	// Choose a random team id
 	std::uniform_int_distribution<int> randTeam(0, getNrTeams() - 1);
@@ -874,6 +1468,8 @@ TeamSet Instance::getRandTeams(const std::vector<int> values, const std::vector<
 void Instance::removeConstraint(Constraint* c){
 	for (auto it = constraints.begin(); it != constraints.end(); ++it) {
 	    if (*it == c) {
+	        constraintQueries.erase(c);
+	        constraintsVersion = ScheduleState::nextVersion();
 	        delete *it;                // free the object
 	        constraints.erase(it);     // erase the pointer from the list
 	        break;                     // done — only one match expected
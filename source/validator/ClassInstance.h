@@ -13,7 +13,9 @@ Singleton pattern:
 // Include other
 #include "Globals.h"
 #include "ClassConstraint.h"
+#include "ClassConstraintBatch.h"
 #include "ClassMeeting.h"
+#include "ClassMeetingStore.h"
 #include "ClassLeague.h"
 #include "ClassLeagueGroup.h"
 #include "ClassSlot.h"
@@ -21,6 +23,18 @@ Singleton pattern:
 #include "ClassTeam.h"
 #include "ClassTeamGroup.h"
 #include "ClassException.h"
+#include "ClassIdIndex.h"
+#include "ClassGroupIndex.h"
+#include "ClassPackedSchedule.h"
+#include "ClassProfiler.h"
+#include "ClassQueryStats.h"
+#include "ClassScheduleState.h"
+#include "ClassTracer.h"
+
+// Include std
+#include <deque>
+#include <memory>
+#include <unordered_map>
 
 class Instance
 {
@@ -35,79 +49,100 @@ public:
 		delete iInstance;
 		iInstance = NULL;
 	}	
+
+	// Make another instance object the active one, and return the previously active instance.
+	// The caller takes ownership of the returned object, and frees it with destroy().
+	static Instance* swap(Instance* other) {
+		Instance* prev = iInstance;
+		iInstance = other;
+		return prev;
+	}
+
+	static void destroy(Instance* i) { delete i; }
 	
 	// Modify league map
 	void addLeague(League*);
-	League* getLeague(int id) { return leagues.at(id); }
-	LeagueMap getLeagues() const{ return leagues; } 
+	League* getLeague(int id) { return leagueIndex.at(id, leagues); }
+	const LeagueMap& getLeagues() const{ return leagues; } 
 	int getNrLeagues() const{ return leagues.size(); }
 	
 	// Modify league group map
 	void addLeagueGroup(LeagueGroup*);
-	LeagueGroup* getLeagueGroup(int id) { return leagueGroups.at(id); }
-	LeagueGroupMap getLeagueGroups() const{ return leagueGroups; }
+	LeagueGroup* getLeagueGroup(int id) { return leagueGroupIndex.at(id, leagueGroups); }
+	const LeagueGroupMap& getLeagueGroups() const{ return leagueGroups; }
 
 	// Modify team map
 	void addTeam(Team*);
-	Team* getTeam(const int id) const{ return teams.at(id); } 
+	Team* getTeam(const int id) const{ return teamIndex.at(id, teams); } 
 	Team* getRandTeam();
 	TeamSet getRandTeams(const std::vector<int> values, const std::vector<int> weights, std::vector<int> teamIds);
-	TeamMap getTeams() const{ return teams; }
+	const TeamMap& getTeams() const{ return teams; }
 	int getNrTeams() const{ return teams.size(); }
 	TeamSet collectTeams(TeamSet teams, TeamGroupSet teamGroups);
 
 	// Modify team group map
 	void addTeamGroup(TeamGroup*);
-	TeamGroup* getTeamGroup(int id) { return teamGroups.at(id); }
-	TeamGroupMap getTeamGroups() const{ return teamGroups; }
+	TeamGroup* getTeamGroup(int id) { return teamGroupIndex.at(id, teamGroups); }
+	const TeamGroupMap& getTeamGroups() const{ return teamGroups; }
 
 	// Modify slot map
 	void addSlot(Slot*);
 	void removeSlot(Slot*);
-	Slot* getSlot(const int id) const{ return slots.at(id); }
+	Slot* getSlot(const int id) const{ return slotIndex.at(id, slots); }
 	Slot* getRandSlot();
 	SlotSet getRandSlots(const std::vector<int> values, const std::vector<int> weights);
-	SlotMap getSlots() const{ return slots; }
+	const SlotMap& getSlots() const{ return slots; }
 	int getNrSlots() const{ return slots.size(); }
 	SlotSet collectSlots(SlotSet slots, SlotGroupSet slotGroups);
+	// Slots and the members of slot groups as a bit row over the slot ids, as PackedSchedule::slotMask
+	SlotMask collectSlotMask(const SlotSet& slots, const SlotGroupSet& slotGroups);
+
+	// Interned unions of teams and team groups, and of slots and slot groups: all constraints that reference the same
+	// teams or slots share one resolved set. Interned sets stay valid until a team, slot, or group is added or removed.
+	const TeamSet& internTeams(const TeamSet& teams, const TeamGroupSet& teamGroups);
+	int internSlots(const SlotSet& slots, const SlotGroupSet& slotGroups);
+	const SlotSet& getInternedSlots(const int id) const { return internedSlots[id].all; }
+	// The interned slot set as increasing ranges of consecutive slot ids: (first, last)
+	const std::vector<std::pair<int, int>>& getSlotRanges(const int id) const { return internedSlots[id].ranges; }
+
+	// Number of home (H), away (A), or all (HA) games of a team in the interned slot set with the given id, as a
+	// subtraction of prefix sums per range of the set
+	int nrGames(Team* t, const int slotsId, const HomeMode mode);
 
 	// Modify slot group map
 	void addSlotGroup(SlotGroup*);
-	SlotGroup* getSlotGroup(int id) { return slotGroups.at(id); }
-	SlotGroupMap getSlotGroups() const{ return slotGroups; }
+	SlotGroup* getSlotGroup(int id) { return slotGroupIndex.at(id, slotGroups); }
+	const SlotGroupMap& getSlotGroups() const{ return slotGroups; }
 
 	// Modify constraint list
-	void addConstraint(Constraint* c) { constraints.push_back(c); }
+	void addConstraint(Constraint* c) { constraints.push_back(c); constraintQueries[c]; constraintsVersion = ScheduleState::nextVersion(); }
 	void removeConstraint(Constraint* c);
 	ConstraintList getCnstrs() { return constraints; }
 
 	// Modify objective
-	void setObjective(const ObjMode o) { objectiveMode = o; }
+	void setObjective(const ObjMode o) { objectiveMode = o; objectiveVersion = ScheduleState::nextVersion(); }
 	ObjMode getObjective() const { return objectiveMode; }
 	void setObjectiveValue(const ObjCost c) { objectiveValue = c; }
 	ObjCost getObjectiveValue() const{ return objectiveValue; }
 
 	// Modify distances and costs
-	void setDistance(Team* t1, Team* t2, const int dist) { distances[std::make_pair(t1,t2)] = dist; }
+	void setDistance(Team* t1, Team* t2, const int dist) { distances[std::make_pair(t1,t2)] = dist; distanceTable.built = false; objectiveVersion = ScheduleState::nextVersion(); }
 	int getDistance(Team* t1, Team* t2) const { return distances.at(std::make_pair(t1,t2)); }
 	int getDistance(int teamId1, int teamId2) const { return getDistance(getTeam(teamId1), getTeam(teamId2)); }
-	AttrMapList serializeDistances();
-	DistanceMap getDistances() { return distances; }
+	const DistanceMap& getDistances() const{ return distances; }
 	bool isSetDistance(Team* t1, Team* t2) const { return distances.count(std::make_pair(t1,t2)); }
 
-	void setCOEWeight(Team* t1, Team* t2, const int weight) { COEWeights[std::make_pair(t1,t2)] = weight; }
+	void setCOEWeight(Team* t1, Team* t2, const int weight) { COEWeights[std::make_pair(t1,t2)] = weight; COEWeightTable.built = false; objectiveVersion = ScheduleState::nextVersion(); }
 	int getCOEWeight(Team* t1, Team* t2) const { return COEWeights.at(std::make_pair(t1,t2)); }
 	int getCOEWeight(int teamId1, int teamId2) const { return getCOEWeight(getTeam(teamId1), getTeam(teamId2)); }
-	AttrMapList serializeCOEWeights();
-	DistanceMap getCOEWeights() { return COEWeights; }
+	const DistanceMap& getCOEWeights() const{ return COEWeights; }
 	bool isSetCOEWeight(Team* t1, Team* t2) const { return COEWeights.count(std::make_pair(t1,t2)); }
 	bool isSetCOEWeight(int teamId1, int teamId2) const { return isSetCOEWeight(getTeam(teamId1), getTeam(teamId2)); }
 
-	void setCost(Team* t1, Team* t2, Slot* s, const int cost) { costs[std::make_tuple(t1, t2, s)] = cost; }
+	void setCost(Team* t1, Team* t2, Slot* s, const int cost) { costs[std::make_tuple(t1, t2, s)] = cost; costTable.built = false; objectiveVersion = ScheduleState::nextVersion(); }
 	int getCost(Team* t1, Team* t2, Slot* s) const { return costs.at(std::make_tuple(t1, t2, s)); }
 	int getCost(int teamId1, int teamId2, int slotId) const { return getCost(getTeam(teamId1), getTeam(teamId2), getSlot(slotId)); }
-	CostMap getCosts() { return costs; }
-	AttrMapList serializeCosts();
+	const CostMap& getCosts() const{ return costs; }
 	bool isSetCost(Team* t1, Team* t2, Slot* s) const { return costs.count(std::make_tuple(t1,t2, s)); }
 
 	// Modify meetings
@@ -116,10 +151,48 @@ public:
 	void scheduleMeeting(Team* h, Team* a, Slot* s);
 	void clearSchedule();
 
+	// Prepare for the next solution of the same instance: restore the meetings as generated, forget the objective value,
+	// and restore the meta data that the previous solution overwrote. Teams, slots, constraints, and all indexes and
+	// interned sets are kept, such that this is O(|M|). Statistics of the queries and of the bounded evaluation are kept
+	// as well; they do not change the result of a check.
+	void resetSolution();
+
+	// Dense copy of the schedule, rebuilt when the schedule changed since the previous call
+	const PackedSchedule& getPackedSchedule();
+
+	// Counts of constraint c by the pass of its batch over the packed schedule, see ConstraintBatch, or NULL if c is not
+	// in a batch or the schedule cannot be packed. The pass evaluates all members of the batch at once, on the first call
+	// of a member after the schedule changed.
+	const int* getBatchCounts(const Constraint* c);
+
+	// Schedule states: the meetings of the calling thread are those of the state bound to the thread, or otherwise of
+	// the own state of the instance. States are copy-on-write, such that a snapshot costs a reference, and many schedules
+	// can be evaluated in parallel against one instance without copying it.
+	std::shared_ptr<ScheduleState> getSchedule() { return meetings.shareState(); }
+	void setSchedule(std::shared_ptr<ScheduleState> s) { meetings.setState(s); }
+	static void bindSchedule(std::shared_ptr<ScheduleState> s) { MeetingStore::bindState(s); }
+	// Stamp of the schedule of the calling thread, which changes with the schedule and with the teams and slots
+	unsigned long getScheduleVersion() const { return std::max(modelVersion, meetings.getState().version); }
+
+	// Build all indexes, interned sets, and dense tables that are otherwise built on first use, such that evaluating a
+	// schedule only reads the instance. Holds until the instance is changed.
+	void freeze();
+	// Cost of every schedule under the current penalties and types, as reweigh, evaluated by nrThreads threads. The
+	// objective value of the instance is not changed, and the deviations are kept in the cache of every schedule, such
+	// that a schedule that is set afterwards is reweighed without checking it again. With profiling or tracing enabled,
+	// the schedules are evaluated on the calling thread, as the statistics are not synchronized.
+	std::vector<ObjCost> evaluateSchedules(const std::vector<std::shared_ptr<ScheduleState>>& schedules, const int nrThreads);
+	// Stream for the violations reported by the checks: cout, except on the threads of evaluateSchedules
+	static std::ostream& report();
+
 	// Modify meta-data
 	void setInstanceName(const std::string n, const std::string schema) { instanceName = n; xmlSchemaIn = schema; }
 	std::string getInstanceName() const { return instanceName; }
 	std::string getSchemaIn() const { return xmlSchemaIn; }
+	// The hash of an instance read from a file is only calculated when it is first needed
+	void setInstanceFile(const std::string file) { instanceFile = file; instanceHashed = false; }
+	void setInstanceHash(const uint64_t h) { instanceFile = ""; instanceHash = h; instanceHashed = true; }
+	uint64_t getInstanceHash();
 	void setSolutionName(const std::string n, const std::string schema) { solutionName = n; xmlSchemaSol = schema; }
 	std::string getSolutionName() const { return solutionName; }
 	std::string getSchemaSol() const { return xmlSchemaSol; }
@@ -139,15 +212,26 @@ public:
 	SolutionMethod getSolutionMethod() const{ return solMethod; }
 	void setLowerBound(const ObjCost lb) { lowerBound = lb; }
 	ObjCost getLowerBound() const{ return lowerBound; }
+	// Save the meta data of the instance itself, to be restored by resetSolution
+	void saveInstanceMetaData();
+	bool isSavedInstanceMetaData() const { return metaDataSaved; }
 
 	// Querry games
-	MeetingList getMeetings() const{ return meetings; }
+	MeetingList getMeetings() { countQuery(QueryStats::ALL, meetings.size(), meetings.size()); return meetings.getAll(); }
 	MeetingList getMeetingsTeam(TeamSet teams, HomeMode mode);
 	MeetingList getMeetingsSlot(SlotSet slots);
 	MeetingList getMeetingsTeamSlot(TeamSet teams, SlotSet slots, HomeMode mode);
 	MeetingList getMeetingsTeamSlotGroup(TeamSet teams, SlotGroupSet slotGroups, HomeMode mode);
 	MeetingList getMeetingsTeamTeamSlot(TeamSet teams1, TeamSet teams2, SlotSet slots, HomeMode mode);
 	MeetingList getMeetingsTeamTeam(TeamSet teams1, TeamSet teams2, HomeMode mode);
+	unsigned long getNrMeetingsScanned() const { return queryStats.getVisited(); }
+
+	// Statistics of the meeting queries, in total and per constraint
+	const QueryStats& getQueryStats() const { return queryStats; }
+	const QueryStats& getQueryStats(const Constraint* c) const;
+	void clearQueryStats();
+	void printQueryStats(std::ostream& out) const;
+	void printQueryStatsJson(std::ostream& out) const;
 
 	// Calculate the carry-over effects value
 	int carryOver(League* l);
@@ -163,7 +247,20 @@ public:
 
 	// Check all constraints
 	void checkConstr(bool silent);	
+
+	// Check all constraints, but stop as soon as the running cost exceeds the bound. A component of the bound equal to
+	// -1 is not bounded; if both are bounded, the cost is compared lexicographically, as an incumbent.
+	// Returns false if the bound was exceeded, in which case the objective value is only a lower bound.
+	bool checkConstrBounded(const ObjCost bound, bool silent);
+
+	// Cost of the schedule under the current penalties and types of the constraints. Only constraints that were not
+	// checked since the last change of the schedule are evaluated, such that changing penalties or flipping constraints
+	// between HARD and SOFT is a sum over the constraints. The objective value from the XML file is not changed.
+	ObjCost reweigh();
 	int calculateObj();
+	// Deviation of a constraint in the last check on the schedule of the calling thread, -1 if it was not checked since
+	// the schedule changed
+	int getDeviation(const Constraint* c) const;
 
 	// Classify the instance
 	std::string classify();
@@ -174,9 +271,44 @@ public:
 
 private:
 	// constructor
-	Instance() {}
+	Instance();
 	virtual ~Instance();
 
+	// Check a single constraint, and record its statistics if profiling or tracing is enabled
+	ObjCost evaluate(Constraint* c);
+
+	// Cost of the schedule of the calling thread, as reweigh, without changing cout
+	ObjCost scheduleCost();
+
+	// Stamps of the caches of a schedule state: the deviations depend on the schedule and the constraint list, the
+	// fixed cost also on the objective
+	unsigned long getDeviationVersion() const { return std::max(getScheduleVersion(), constraintsVersion); }
+	unsigned long getFixedVersion() const { return std::max(getDeviationVersion(), objectiveVersion); }
+
+	// Check the base constraints: BA1, unless the constraint list has a soft variant, and BA2
+	void checkBase(ObjCost& result);
+
+	// Check the symmetric structure of every league, adding one to the infeasibility per violation
+	void checkSymmetry(ObjCost& result);
+
+	// Expected number of violations per second of a constraint type, in HARD or SOFT form
+	double getPriority(const std::string name, const CType type) const;
+
+	// Count a meeting query, in total and for the constraint that is being checked
+	void countQuery(const QueryStats::Query q, const unsigned long visited, const unsigned long returned);
+
+	// Rebuild the membership index of the team and slot groups if a team, slot, or group was added since
+	void indexGroups();
+
+	// Group the CA2 and CA4 constraints of the list in batches of the same type and modes, if the constraint list, a
+	// team, slot, or group changed since
+	void batchConstraints();
+
+	// Dense copies of the distance, carry-over weight, and cost maps, indexed by team and slot ids
+	const DenseTable& getDistanceTable();
+	const DenseTable& getCOEWeightTable();
+	const DenseTable& getCostTable();
+
 protected:
 	// Type here all protected variables
 	
@@ -191,9 +323,42 @@ protected:
 	LeagueMap leagues; 			// Map with ownership over all league objects: key = id, value = pointer to league object
 	LeagueGroupMap leagueGroups; 		// Map with ownership over all league group objects: key = id, value = pointer to league group object
 
+	IdIndex<Team> teamIndex; 		// Array lookup of the ids in the maps above
+	IdIndex<TeamGroup> teamGroupIndex;
+	IdIndex<Slot> slotIndex;
+	IdIndex<SlotGroup> slotGroupIndex;
+	IdIndex<League> leagueIndex;
+	IdIndex<LeagueGroup> leagueGroupIndex;
+	GroupIndex<TeamGroup> teamGroupMembers; 	// Membership of the team groups
+	GroupIndex<SlotGroup> slotGroupMembers; 	// Membership of the slot groups
+	bool groupsIndexed = false; 		// False if the group indexes are out of date
+
+	std::vector<ConstraintBatch> batches; 	// Batches of the constraint list
+	std::unordered_map<const Constraint*, std::pair<int, int>> batchMembers; 	// Constraint -> (batch, member)
+	unsigned long batchedVersion = -1; 	// Stamp of the constraint list that was batched, -1 if out of date
+	unsigned long batchesVersion = 0; 	// Stamp of the last rebuild of the batches
+
+	struct InternedTeams {
+		TeamSet teams; 			// Teams and groups of the union, to tell unions with the same hash apart
+		TeamGroupSet teamGroups;
+		TeamSet all;
+	};
+	struct InternedSlots {
+		SlotSet slots;
+		SlotGroupSet slotGroups;
+		SlotSet all;
+		std::vector<std::pair<int, int>> ranges; 	// Maximal ranges of consecutive slot ids in the union
+	};
+	std::unordered_multimap<uint64_t, int> teamSetIds; 	// Hash of the ids -> index in internedTeams
+	std::deque<InternedTeams> internedTeams;
+	std::unordered_multimap<uint64_t, int> slotSetIds; 	// Hash of the ids -> index in internedSlots
+	std::deque<InternedSlots> internedSlots;
+
 	ConstraintList constraints; 		// List with ownership over all constraint objects: value = pointer to constraint object
+	Constraint* baseGames; 			// Base constraints of checkBase, BA1 and BA2: kept for the lifetime of the
+	Constraint* baseSlots; 			// instance, such that the profiler tells them apart
 
-	MeetingList meetings; 			// List with ownership over all meeting objects: value = pointer to meeting object
+	MeetingStore meetings; 			// Store with ownership over all meetings, and their handles
 
 	DistanceMap distances; 			// Map that contains all pairwise distances between all teams. distances[pair(team1, team2)]
 
@@ -201,6 +366,23 @@ protected:
 
 	CostMap costs; 				// Map that contains all expected costs or revnues . distances[pair(meeting, slot)]
 
+	QueryStats queryStats; 			// Meeting queries of all callers
+	std::map<const Constraint*, QueryStats> constraintQueries; 	// Meeting queries per constraint in the constraint list
+	QueryStats otherQueries; 		// Meeting queries outside the constraint list: base constraints, symmetry, and objective
+
+	struct TypeStats {
+		long calls = 0;
+		long violations = 0;
+		double seconds = 0;
+	};
+	std::map<std::pair<std::string, CType>, TypeStats> typeStats; 	// Statistics of bounded evaluations per constraint type
+	unsigned long modelVersion = 0; 	// Stamp of the last change of the teams, slots, or meetings that were added
+	unsigned long objectiveVersion = 0; 	// Stamp of the last change of the objective or its data
+	unsigned long constraintsVersion = 0; 	// Stamp of the last change of the constraint list
+	DenseTable distanceTable; 		// distanceTable[team1*|T| + team2]
+	DenseTable COEWeightTable; 		// COEWeightTable[team1*|T| + team2]
+	DenseTable costTable; 			// costTable[(team1*|T| + team2)*|S| + slot]
+
 	ObjMode objectiveMode = NONEOBJ;	// Objective mode
 	
 						// Cost of solution: (infeasibility value, feasibility value)
@@ -209,6 +391,9 @@ protected:
 	// Meta Data
 	std::string instanceName = "NULL"; 	// Name of the instance
 	std::string xmlSchemaIn = "NUL";
+	std::string instanceFile = ""; 		// XML file the instance was read from, if any
+	uint64_t instanceHash = 0; 		// Hash of the instance XML content, zero if unknown
+	bool instanceHashed = true; 		// False until the hash of the instance file is calculated
 	std::string solutionName = "NULL"; 	// Name of the solution
 	std::string xmlSchemaSol = "NULL";
 	DataType dataType = NONEDAT; 		// Data type: real life or artificial
@@ -220,6 +405,18 @@ protected:
 	std::string remarks = "NULL";
 	SolutionMethod solMethod = NONESOL;
 	ObjCost lowerBound = {0,0};
+
+	struct InstanceMetaData { 		// Meta data that the meta data of a solution overwrites
+		std::string instanceName;
+		std::string xmlSchemaIn;
+		std::string contributor;
+		std::tuple<int, int, int> date;
+		std::string remarks;
+		SolutionMethod solMethod;
+		ObjCost lowerBound;
+	};
+	InstanceMetaData savedMetaData;
+	bool metaDataSaved = false; 		// False if the meta data of the instance was not saved yet
 };
 
 #endif /* CLASSINSTANCE_H */
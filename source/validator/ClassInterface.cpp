@@ -1,16 +1,15 @@
 #include "ClassInterface.h"
-
+#include <cctype>       // std::isspace
+#include <cstdlib>      // std::strtol
+#include <deque>        // open meetings of the random timetable
+#include <fstream>      // compact schedule files
+#include <functional>   // std::function
 
 // The following headers are needed by the random schedule generation method
 #include <algorithm>    // std::shuffle
 #include <random>       // std::default_random_engine
-#include <chrono>       // std::chrono::system_clock
-
-// The following headers are needed for Vizing's algorithm
-#include <boost/config.hpp>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/edge_coloring.hpp>
-#include <boost/graph/properties.hpp>
+#include <numeric>      // std::iota
+#include "ClassOneFactorization.h" // random 1RR opponent schedules
 
 // TODO
 // Cplex functionality removed for online github version
@@ -123,12 +122,15 @@ void Interface::addCost(int teamId1, int teamId2, int slotId, int cost){
 	}
 }
 void Interface::addInstanceName(const std::string name, const std::string schema) { INS->setInstanceName(name, schema); }
-void Interface::readInstanceXml(std::string xmlFile, std::string xmlSchema){
+bool Interface::readInstanceXml(std::string xmlFile, std::string xmlSchema){
+	Tracer::Span span("readInstanceXml", "parser");
 	// Initialize parser to read the sol file
 	addInstanceName(xmlFile);
+	INS->setInstanceFile(xmlFile);
 
 	// XML files can be large: put on heap
 	TinyParser* p = new TinyParser();
+	bool read = true;
 	try {
 		// Load xml file into memory
 		p->readFile(xmlFile);
@@ -136,18 +138,25 @@ void Interface::readInstanceXml(std::string xmlFile, std::string xmlSchema){
 		// Try to parse the file
 		p->deserializeInstance();	
 
+		// Restored when the next solution is read
+		INS->saveInstanceMetaData();
+
 	} catch(XmlReadingException e) {
 		std::cout << e.what() << std::endl;
+		read = false;
 	}
 
 	// Free the memory	
 	delete p;
+	return read;
 }
 
 void Interface::readInstanceXmlString(std::string xmlContent, std::string xmlSchema){
+	Tracer::Span span("readInstanceXml", "parser");
 	// Initialize parser to read the sol file
 	std::string xmlFile = "fromString";
 	addInstanceName(xmlFile);
+	INS->setInstanceHash(hashString(xmlContent));
 
 	// XML files can be large: put on heap
 	TinyParser* p = new TinyParser();
@@ -158,6 +167,9 @@ void Interface::readInstanceXmlString(std::string xmlContent, std::string xmlSch
 		// Try to parse the file
 		p->deserializeInstance();	
 
+		// Restored when the next solution is read
+		INS->saveInstanceMetaData();
+
 	} catch(XmlReadingException e) {
 		std::cout << e.what() << std::endl;
 	}
@@ -166,8 +178,14 @@ void Interface::readInstanceXmlString(std::string xmlContent, std::string xmlSch
 	delete p;
 }
 
-void Interface::addSolutionName(const std::string name, const std::string schema) { INS->setSolutionName(name, schema); }
+void Interface::addSolutionName(const std::string name, const std::string schema) {
+	// Instances that were not read from XML keep their meta data from before the first solution
+	if (!INS->isSavedInstanceMetaData()) { INS->saveInstanceMetaData(); }
+	INS->setSolutionName(name, schema);
+}
+void Interface::resetSolution() { INS->resetSolution(); }
 void Interface::readSolutionXml(std::string xmlFile, std::string xmlSchemaIn, std::string xmlSchemaSol, bool readIn){
+	Tracer::Span span("readSolutionXml", "parser");
 	// Initialize parser to read the sol file
 	addSolutionName(xmlFile);
 
@@ -188,6 +206,7 @@ void Interface::readSolutionXml(std::string xmlFile, std::string xmlSchemaIn, st
 	delete p;
 }
 void Interface::readSolutionXmlString(std::string xmlContent, std::string xmlSchemaIn, std::string xmlSchemaSol, bool readIn){
+	Tracer::Span span("readSolutionXml", "parser");
 	// Initialize parser to read the sol file
 	std::string xmlFile = "fromString";
 	addSolutionName(xmlFile);
@@ -202,12 +221,177 @@ void Interface::readSolutionXmlString(std::string xmlContent, std::string xmlSch
 		p->deserializeSolution(readIn);	
 
 	} catch(XmlReadingException e) {
-		std::cout << e.what() << std::endl;
+		// Callers of the string version cannot tell a partially read solution from a complete one
+		delete p;
+		throw_line_robinx(InterfaceReadingException, e.what());
 	}
 
 	// Free the memory	
 	delete p;
 }
+void Interface::readSolutionTriplesString(std::string content){
+	// Solution given as a list of (home, away, slot) triples. Numbers can be separated by 
+	// spaces, tabs, commas, semicolons, or newlines
+	addSolutionName("fromString");
+	std::vector<int> values;
+	const char* p = content.c_str();
+	const char* end = p + content.size();
+	while (p < end) {
+		if (std::isspace(*p) || *p == ',' || *p == ';') { ++p; continue; }
+		char* next;
+		const long value = std::strtol(p, &next, 10);
+		if (next == p) {
+			std::stringstream msg;
+			msg << "Unexpected character '" << *p << "' in list of scheduled games." << std::endl;
+			throw_line_robinx(InterfaceReadingException, msg.str());
+		}
+		values.push_back(value);
+		p = next;
+	}
+	if (values.size() % 3 != 0) {
+		std::stringstream msg;
+		msg << "List of scheduled games has " << values.size() << " numbers, which is not a multiple of three." << std::endl;
+		throw_line_robinx(InterfaceReadingException, msg.str());
+	}
+	for (size_t i = 0; i < values.size(); i += 3) {
+		scheduleMeeting(values[i], values[i+1], values[i+2]);
+	}
+}
+// Header of a compact schedule file: "home,away,slot", with optional whitespace
+static bool isCsvHeader(const std::string& line){
+	std::string compact;
+	for (char ch : line) {
+		if (!std::isspace((unsigned char) ch)) { compact += ch; }
+	}
+	return compact == "home,away,slot";
+}
+void Interface::readSolutionCsv(std::string csvFile){
+	// One "home,away,slot" line per scheduled game, optionally preceded by the header line "home,away,slot"
+	std::ifstream file(csvFile);
+	if (!file) {
+		throw_line_robinx(InterfaceReadingException, "Cannot open schedule file " + csvFile + ".");
+	}
+	addSolutionName(csvFile);
+	std::string line;
+	for (int lineNr = 1; std::getline(file, line); ++lineNr) {
+		if (lineNr == 1 && isCsvHeader(line)) { continue; }
+		if (line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+
+		// Three numbers separated by commas, surrounded by optional whitespace
+		int ids[3];
+		const char* p = line.c_str();
+		bool valid = true;
+		for (int i = 0; i < 3 && valid; ++i) {
+			char* next;
+			ids[i] = std::strtol(p, &next, 10);
+			valid = (next != p);
+			p = next;
+			while (*p == ' ' || *p == '\t' || *p == '\r') { ++p; }
+			if (valid && i < 2) {
+				valid = (*p == ',');
+				++p;
+			}
+		}
+		if (!valid || *p != '\0') {
+			std::stringstream msg;
+			msg << "Line " << lineNr << " of " << csvFile << " is not a \"home,away,slot\" triple: " << line << std::endl;
+			throw_line_robinx(InterfaceReadingException, msg.str());
+		}
+		scheduleMeeting(ids[0], ids[1], ids[2]);
+	}
+}
+void Interface::writeSolutionCsv(std::string csvFile){
+	std::ofstream file(csvFile);
+	if (!file) {
+		std::cout << "Cannot write schedule file " << csvFile << "." << std::endl;
+		return;
+	}
+	file << "home,away,slot\n";
+	for (auto m : INS->getMeetings()) {
+		if (m->getAssignedSlot() != NULL) {
+			file << m->getFirstTeam()->getId() << "," << m->getSecondTeam()->getId() << "," << m->getAssignedSlot()->getId() << "\n";
+		}
+	}
+}
+
+// Binary schedule layout, all numbers little endian:
+//	"RBXS", uint32 version, uint64 instance hash, uint32 number of games,
+//	followed by a uint16 home, away, and slot id for every game
+static const char SCHEDULE_MAGIC[4] = {'R', 'B', 'X', 'S'};
+static const uint32_t SCHEDULE_VERSION = 1;
+
+static void writeLE(std::ostream& out, uint64_t value, const int nrBytes){
+	for (int i = 0; i < nrBytes; ++i) {
+		out.put((char) ((value >> (8*i)) & 0xFF));
+	}
+}
+static uint64_t readLE(const unsigned char* in, const int nrBytes){
+	uint64_t value = 0;
+	for (int i = 0; i < nrBytes; ++i) {
+		value |= (uint64_t) in[i] << (8*i);
+	}
+	return value;
+}
+
+void Interface::readSolutionBinary(std::string binFile){
+	// A file that cannot be read completely, or that belongs to another instance, cancels the validation
+	addSolutionName(binFile);
+	std::ifstream file(binFile, std::ios::in | std::ios::binary);
+	if (!file) {
+		throw_line_robinx(InterfaceReadingException, "Cannot open schedule file " + binFile + ".");
+	}
+	std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	const unsigned char* data = (const unsigned char*) content.data();
+	if (content.size() < 20 || content.compare(0, 4, SCHEDULE_MAGIC, 4) != 0 || readLE(data + 4, 4) != SCHEDULE_VERSION) {
+		throw_line_robinx(InterfaceReadingException, "File " + binFile + " is not a binary schedule of this RobinX version.");
+	}
+	const uint64_t hash = readLE(data + 8, 8);
+	if (hash != 0 && INS->getInstanceHash() != 0 && hash != INS->getInstanceHash()) {
+		throw_line_robinx(InterfaceReadingException, "Schedule " + binFile + " was written for another instance than " + INS->getInstanceName() + ".");
+	}
+	const uint64_t nrGames = readLE(data + 16, 4);
+	if (content.size() != 20 + 6*nrGames) {
+		throw_line_robinx(InterfaceReadingException, "Schedule " + binFile + " is truncated.");
+	}
+	for (const unsigned char* g = data + 20; g < data + content.size(); g += 6) {
+		scheduleMeeting(readLE(g, 2), readLE(g + 2, 2), readLE(g + 4, 2));
+	}
+}
+void Interface::writeSolutionBinary(std::string binFile){
+	MeetingList scheduled;
+	try {
+		for (auto m : INS->getMeetings()) {
+			if (m->getAssignedSlot() == NULL) { continue; }
+			const int ids[3] = {m->getFirstTeam()->getId(), m->getSecondTeam()->getId(), m->getAssignedSlot()->getId()};
+			for (int id : ids) {
+				if (id < 0 || id > 0xFFFF) {
+					std::stringstream msg;
+					msg << "Id " << id << " does not fit in a binary schedule." << std::endl;
+					throw_line_robinx(OutOfBoundsException, msg.str());
+				}
+			}
+			scheduled.push_back(m);
+		}
+	} catch(OutOfBoundsException e) {
+		std::cout << e.what() << std::endl;
+		return;
+	}
+
+	std::ofstream file(binFile, std::ios::out | std::ios::binary);
+	if (!file) {
+		std::cout << "Cannot write schedule file " << binFile << "." << std::endl;
+		return;
+	}
+	file.write(SCHEDULE_MAGIC, 4);
+	writeLE(file, SCHEDULE_VERSION, 4);
+	writeLE(file, INS->getInstanceHash(), 8);
+	writeLE(file, scheduled.size(), 4);
+	for (auto m : scheduled) {
+		writeLE(file, m->getFirstTeam()->getId(), 2);
+		writeLE(file, m->getSecondTeam()->getId(), 2);
+		writeLE(file, m->getAssignedSlot()->getId(), 2);
+	}
+}
 void Interface::writeInstanceXml(std::string xmlFile){
 	// XML files can be large: put on heap
 	TinyParser* p = new TinyParser();
@@ -261,6 +445,7 @@ void Interface::addObjectiveValue(const int infeasibilityValue, const int feasib
 void Interface::addConstraint(Constraint* c) { INS->addConstraint(c); }	
 void Interface::addMeeting(int teamId1, int teamId2, bool noHome, int slot) { INS->addMeeting(INS->getTeam(teamId1), INS->getTeam(teamId2), noHome, slot); }
 void Interface::generateMeetings() { 
+	Tracer::Span span("generateMeetings", "parser");
 	for (auto l:INS->getLeagues()) {
 		INS->generateMeeting(l.second); 
 	}
@@ -269,6 +454,12 @@ ObjCost Interface::checkConstr(bool silent) {
 	INS->checkConstr(silent); 
 	return INS->getObjectiveValue();
 }
+bool Interface::checkConstrBounded(const ObjCost bound, bool silent) { return INS->checkConstrBounded(bound, silent); }
+ObjCost Interface::reweigh() { return INS->reweigh(); }
+std::shared_ptr<ScheduleState> Interface::getSchedule() { return INS->getSchedule(); }
+std::vector<ObjCost> Interface::evaluateSchedules(const std::vector<std::shared_ptr<ScheduleState>>& schedules, const int nrThreads){
+	return INS->evaluateSchedules(schedules, nrThreads);
+}
 std::string Interface::classify(){ return INS->classify(); }
 void Interface::scheduleMeeting(int homeId, int awayId, int slotId){ 
 	Team *t1, *t2;
@@ -448,82 +639,6 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> Interfa
 	return std::make_pair(opponentSchedule, patternSet);
 }
 
-/**
- * Use Vizing algorithm to generate an opponent schedule for a 1RR
- **/
-
-std::vector<std::vector<int>> vizing1RR(const int nrTeams){
-	using namespace boost;
-	// nrTeams = 2n must be even
-	assert(nrTeams%2 == 0);
-
-	const int nrSlotsPhase = nrTeams - 1 + nrTeams%2;
-
-	// Construct the 1RR for |T|-1 teams via edge coloring
-	// See: Costa F. N.; Urrutia, S. & Ribeiro, C. C. An ILS heuristic for the traveling tournament problem with predefined venues Ann. Oper. Res., 2012, 194, 137-150
-	const int nrNodes = nrTeams-1; // K(|T|-1)
-	const int nrEdges = nrNodes*(nrNodes-1)/2; // Complete graph
-
-	typedef adjacency_list<vecS, vecS, undirectedS, no_property, size_t, no_property> Graph;
-
-	Graph G(nrNodes);
-	std::vector<std::pair<int,int>> edges;
-	for (int i = 0; i < nrNodes; ++i) {
-		for (int j = i+1; j < nrNodes; ++j) {
-			edges.push_back(std::make_pair(i,j));
-		}	  
-	}
-
-	// Shuffle the order of the edges
-	unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-	std::shuffle (edges.begin(), edges.end(), std::default_random_engine(seed));
-
-
-	// Add all edges
-	for (auto e : edges) {
-		add_edge(e.first, e.second, G);
-	}
-
-
-	size_t colors = edge_coloring(G, boost::get(edge_bundle, G));
-
-	//std::cout << "Colored using " << colors << " colors" << std::endl;
-	//for (size_t i = 0; i < edges.size(); i++) {
-	//	std::cout << "  " << edges[i].first << " - " << edges[i].second << ": " << G[edge(edges[i].first, edges[i].second, G).first] << std::endl;
-	//}
-
-	// Save unused color for each team
-	std::vector<std::set<int>>  unusedColors (nrNodes);
-	for(int i=0; i < nrNodes; ++i){
-		for(int j=0; j < nrNodes; ++j){
-			unusedColors.at(i).insert(j);
-		}
-	}
-
-	std::vector<std::vector<int>> opponentSchedule(nrTeams, std::vector<int> (nrSlotsPhase, -1));
-	for (size_t i = 0; i < edges.size(); i++) {
-		// Erase from unused color
-		unusedColors.at(edges[i].first).erase(G[edge(edges[i].first, edges[i].second, G).first]);	
-		unusedColors.at(edges[i].second).erase(G[edge(edges[i].first, edges[i].second, G).first]);	
-
-		// Save opponent schedule
-		opponentSchedule.at(edges[i].first).at(G[edge(edges[i].first, edges[i].second, G).first]) = edges[i].second;
-		opponentSchedule.at(edges[i].second).at(G[edge(edges[i].first, edges[i].second, G).first]) = edges[i].first;
-	}
-
-	// Each team should now have exactly one unused color
-	// We can use these colors to schedule all games against the last team
-	for (int i = 0; i < nrNodes; ++i) {
-		assert(unusedColors.at(i).size() == 1);
-
-		// Save in opponent schedule
-		opponentSchedule.at(nrTeams-1).at(*(unusedColors.at(i).begin())) = i;
-		opponentSchedule.at(i).at(*(unusedColors.at(i).begin())) = nrTeams-1;
-	}
-
-	return opponentSchedule;
-}
-
 /**
  * Construct a random timetable.
  * Idea: use a pattern enumeration method
@@ -943,7 +1058,8 @@ std::vector<std::vector<int>> vizing1RR(const int nrTeams){
 
 /**
  * Construct a random timetable.
- * Idea: use Vizing algorithm to generate a 1RR
+ * Idea: generate every 1RR as a random 1-factorization, see OneFactorization. All random choices are drawn from
+ * randEngine and std::rand, such that the timetable only depends on their seeds
  **/
 std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> Interface::randomVizing(const int nrTeams, const int nrRoundRobin, const GameMode symmetry){
 
@@ -951,7 +1067,9 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> Interfa
 	const int nrSlots = nrRoundRobin*nrSlotsPhase;
 
 	// Generate opponent schedule for a 1RR
-	std::vector<std::vector<int>> opponentSchedule = vizing1RR(nrTeams);
+	OneFactorization factorization(nrTeams);
+	factorization.generate(randEngine);
+	std::vector<std::vector<int>> opponentSchedule = factorization.getOpponentSchedule();
 
 	// Initialize other part of opponentSchedule at -1
 	for(int i=0; i < nrTeams; ++i){
@@ -978,10 +1096,10 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> Interfa
 			case P:
 			{
 				// Generate k other 1RR's and shuffle the results in case of NONEGAME
-				std::vector<std::vector<int>> dummy = vizing1RR(nrTeams);
+				factorization.generate(randEngine);
 				for (int i = 0; i < nrTeams; ++i) {
 					for (int s = 0; s < nrSlotsPhase; ++s) {
-						opponentSchedule.at(i).at(k*nrSlotsPhase+s) = dummy.at(i).at(s);	
+						opponentSchedule.at(i).at(k*nrSlotsPhase+s) = factorization.getOpponent(i, s);
 					}	
 				}
 			
@@ -1071,8 +1189,7 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> Interfa
 		// Shuffle the rounds
 		std::vector<int> colIds(nrSlots);
 		for(int i=0; i < nrSlots; i++){ colIds.at(i) = i; }
-		unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-		std::shuffle (colIds.begin(), colIds.end(), std::default_random_engine(seed));
+		std::shuffle (colIds.begin(), colIds.end(), randEngine);
 		std::vector<std::vector<int>> opponentScheduleShuffled(nrTeams, std::vector<int> (nrSlots));
 		std::vector<std::vector<bool>> patternSetShuffled(nrTeams, std::vector<bool> (nrSlots));
 
@@ -1090,6 +1207,161 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> Interfa
 	return std::make_pair(opponentSchedule, patternSet);
 }
 
+/**
+ * Generate a random instance and solution to measure how the validator scales with the size of the league
+ * nrTeams: total number of teams in the instance (must be even)
+ * nrRoundRobin: number of round robins
+ * nrSlots: number of time slots, at least nrRoundRobin*(nrTeams-1). With more slots the timetable is time-relaxed,
+ *	and the rounds of the random timetable are spread over a random subset of the slots
+ * symmetry: symmetric structure of the random timetable, only stored in the instance if it is compact
+ * objMode: objective; TR and CR get random distances or costs
+ * constraintsMap: key=constraint name (e.g. CA1Hard or CA1Soft), value is number of constraints to be generated
+ * seed: seed of std::rand and randEngine, used by the random timetable and the random constraint generators
+ * objectiveValue: validate the timetable to store its objective value in the solution, otherwise the solution
+ *	gets the unknown value -1. Validation takes most of the time for large leagues
+ * Throws an InvalidArgumentException before generating anything if a constraint name has no random generator
+ */
+void Interface::generateScalingInstance(const int nrTeams, const int nrRoundRobin, const int nrSlots, const GameMode symmetry, const ObjMode objMode, const std::map<std::string, int> constraintsMap, const unsigned seed, const bool objectiveValue, std::string fileName, std::string solName){
+	const int nrSlotsPhase = nrTeams - 1;
+	const int nrRounds = nrRoundRobin*nrSlotsPhase;
+	assert(nrTeams%2 == 0);
+	assert(nrSlots >= nrRounds);
+
+	// Random constraint generators, with the penalties of the ITC2021 generator. CA4 samples from the given team pairs
+	typedef std::function<Constraint*(const std::vector<std::pair<int, int>>&)> Generator;
+	const std::map<std::string, Generator> generators = {
+		{"CA1Hard", [](const std::vector<std::pair<int, int>>&) { return new CA1(HARD, 1); }},
+		{"CA1Soft", [](const std::vector<std::pair<int, int>>&) { return new CA1(SOFT, 1); }},
+		{"CA2Hard", [](const std::vector<std::pair<int, int>>&) { return new CA2(HARD, 1); }},
+		{"CA2Soft", [](const std::vector<std::pair<int, int>>&) { return new CA2(SOFT, 5); }},
+		{"CA3Hard", [](const std::vector<std::pair<int, int>>&) { return new CA3(HARD, 1); }},
+		{"CA3Soft", [](const std::vector<std::pair<int, int>>&) { return new CA3(SOFT, 5); }},
+		{"CA4Hard", [](const std::vector<std::pair<int, int>>& pairs) { return new CA4(HARD, 1, pairs); }},
+		{"CA4Soft", [](const std::vector<std::pair<int, int>>& pairs) { return new CA4(SOFT, 5, pairs); }},
+		{"GA1Hard", [](const std::vector<std::pair<int, int>>&) { return new GA1(HARD, 1); }},
+		{"GA1Soft", [](const std::vector<std::pair<int, int>>&) { return new GA1(SOFT, 1); }},
+		{"BR1Hard", [](const std::vector<std::pair<int, int>>&) { return new BR1(HARD, 1); }},
+		{"BR1Soft", [](const std::vector<std::pair<int, int>>&) { return new BR1(SOFT, 5); }},
+		{"BR2Hard", [](const std::vector<std::pair<int, int>>&) { return new BR2(HARD, 1); }},
+		{"BR2Soft", [](const std::vector<std::pair<int, int>>&) { return new BR2(SOFT, 10); }},
+		{"FA2Soft", [](const std::vector<std::pair<int, int>>&) { return new FA2(SOFT, 10); }},
+		{"SE1Soft", [](const std::vector<std::pair<int, int>>&) { return new SE1(SOFT, 10); }}};
+	for (auto c : constraintsMap) {
+		if (!generators.count(c.first)) {
+			throw_line_robinx(InvalidArgumentException, "Constraint name '" + c.first + "' unknown or without random generator.");
+		}
+	}
+
+	std::srand(seed);
+	randEngine.seed(seed);
+
+	// Add league, teams, and slots to instance. Symmetric structures are only checked in compact timetables,
+	// the league of a time-relaxed timetable has no symmetry
+	const bool compact = (nrSlots == nrRounds);
+	addLeague(new League(0, "League 0", nrRoundRobin, compact ? symmetry : NONEGAME, compact ? C : R));
+	for (int i = 0; i < nrTeams; ++i) {
+		addTeam(new Team(i, "Team " + std::to_string(i), 0, {}));
+	}
+	for (int s = 0; s < nrSlots; ++s) {
+		addSlot(new Slot(s, "Slot " + std::to_string(s), {}));
+	}
+	generateMeetings();
+
+	// Every round of the random timetable gets its own slot, in increasing order
+	std::vector<int> roundSlots(nrSlots);
+	std::iota(roundSlots.begin(), roundSlots.end(), 0);
+	std::shuffle(roundSlots.begin(), roundSlots.end(), randEngine);
+	roundSlots.resize(nrRounds);
+	std::sort(roundSlots.begin(), roundSlots.end());
+
+	// The games are assigned to the meetings directly, as scheduleMeeting would: by preference a meeting with
+	// determined home advantage, and otherwise the meeting of the pair with undetermined home advantage.
+	// scheduleMeeting scans all meetings for every game, which is quadratic in the number of meetings
+	std::map<std::pair<int, int>, std::deque<Meeting*>> determined;
+	std::map<std::pair<int, int>, std::deque<Meeting*>> undetermined;
+	for (auto m : INS->getMeetings()) {
+		const int id1 = m->getFirstTeam()->getId();
+		const int id2 = m->getSecondTeam()->getId();
+		if (m->getNoHome()) {
+			undetermined[std::make_pair(std::min(id1, id2), std::max(id1, id2))].push_back(m);
+		} else {
+			determined[std::make_pair(id1, id2)].push_back(m);
+		}
+	}
+	std::pair<std::vector<std::vector<int>>, std::vector<std::vector<bool>>> output = randomVizing(nrTeams, nrRoundRobin, symmetry);
+	for (int i = 0; i < nrTeams; ++i) {
+		for (int r = 0; r < nrRounds; ++r) {
+			if (!output.second.at(i).at(r)) { continue; }
+			const int j = output.first.at(i).at(r);
+			std::deque<Meeting*>& home = determined[std::make_pair(i, j)];
+			std::deque<Meeting*>& either = undetermined[std::make_pair(std::min(i, j), std::max(i, j))];
+			std::deque<Meeting*>& open = home.empty() ? either : home;
+			assert(!open.empty());
+			Meeting* m = open.front();
+			open.pop_front();
+			if (m->getFirstTeam()->getId() != i) { m->swapTeams(); }
+			m->setAssignedSlot(INS->getSlot(roundSlots.at(r)));
+		}
+	}
+
+	// Add objective, distances and costs are drawn between 1 and 99
+	addObjective(objMode);
+	std::uniform_int_distribution<int> randInt100(1, 99);
+	if (objMode == TR) {
+		for (int i = 0; i < nrTeams; ++i) {
+			addDistance(i, i, 0);
+			for (int j = i+1; j < nrTeams; ++j) {
+				// Symmetric distance matrix
+				const int randInt = randInt100(randEngine);
+				addDistance(i, j, randInt);
+				addDistance(j, i, randInt);
+			}
+		}
+	} else if (objMode == CR) {
+		for (int i = 0; i < nrTeams; ++i) {
+			for (int j = 0; j < nrTeams; ++j) {
+				if (i == j) { continue; }
+				for (int s = 0; s < nrSlots; ++s) {
+					addCost(i, j, s, randInt100(randEngine));
+				}
+			}
+		}
+	}
+
+	// Add meta data
+	addInstanceName(fileName);
+	addSolutionName(solName);
+	addContributor("RobinX generator");
+	addDataType(ARTIFICIAL);
+	addSolutionMethod(HEU);
+	addDescription("Random " + std::to_string(nrRoundRobin) + "RR with " + std::to_string(nrTeams) + " teams and " + std::to_string(nrSlots) + " slots, seed " + std::to_string(seed));
+
+	// Pairs to sample from in the CA4 generator
+	std::vector<std::pair<int, int>> teamPairs;
+	for (int i = 0; i < nrTeams; ++i) {
+		for (int j = i+1; j < nrTeams; ++j) {
+			teamPairs.push_back(std::make_pair(i,j));
+		}
+	}
+
+	// Add constraints
+	for (auto c : constraintsMap) {
+		const Generator& generator = generators.at(c.first);
+		for (int i = 0; i < c.second; ++i) {
+			Instance::get()->addConstraint(generator(teamPairs));
+		}
+	}
+
+	// Store the objective value of the timetable in the solution
+	if (objectiveValue) {
+		checkConstr(true);
+	}
+
+	// Save the XML files
+	writeInstanceXml(fileName);
+	writeSolutionXml(solName);
+}
+
 /**
  * Generate a random instance 
  * nrTeams: total number of teams in the instance (must be even)
@@ -1,8 +1,16 @@
 #include "ClassMeeting.h"
+#include "ClassMeetingStore.h"
+#include "ClassSlot.h"
 
-Meeting::Meeting(Team* t1, Team* t2, bool mode, int slot) : team1(t1), team2(t2), noHome(mode) {
-	if (slot >= 0) { assignedSlot = Instance::get()->getSlot(slot); }
-}
+Team* Meeting::getFirstTeam() const{ return store->getFirstTeam(index); }
+Team* Meeting::getSecondTeam() const{ return store->getSecondTeam(index); }
+void Meeting::setFirstTeam(Team* t) { store->setFirstTeam(index, t); }
+void Meeting::setSecondTeam(Team* t) { store->setSecondTeam(index, t); }
+void Meeting::swapTeams() { store->swapTeams(index); }
+Slot* Meeting::getAssignedSlot() const{ return store->getAssignedSlot(index); }
+void Meeting::setAssignedSlot(Slot* newSlot) { store->setAssignedSlot(index, newSlot); }
+bool Meeting::getNoHome() const{ return store->getNoHome(index); }
+void Meeting::setNoHome(const bool newMod) { store->setNoHome(index, newMod); }
 
 // Comparator functions
 // Sort meetings in increasing scheduled slot
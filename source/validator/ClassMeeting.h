@@ -1,36 +1,40 @@
 #ifndef CLASSMEETING_H
 #define CLASSMEETING_H
 
-#include "ClassTeam.h"
-#include "ClassSlot.h"
+#include "Globals.h"
 
+class MeetingStore;
+
+// Handle of a meeting in the meeting store of the instance
 class Meeting
 {
 public:
 	// constructor
-	Meeting(Team* t1, Team* t2, bool mode, int slot = -1);
+	Meeting(MeetingStore* store, int index) : store(store), index(index) {}
 	~Meeting() {}
 	
+	// Index in the meeting store
+	int getIndex() const{ return index; }
+
 	// Team modifiers
-	Team* getFirstTeam() const{ return team1; }
-	Team* getSecondTeam() const{ return team2; }
-	void setFirstTeam(Team* t) { team1 = t; }
-	void setSecondTeam(Team* t) { team2 = t; }
-	void swapTeams() { std::swap(team1, team2); }
+	Team* getFirstTeam() const;
+	Team* getSecondTeam() const;
+	void setFirstTeam(Team* t);
+	void setSecondTeam(Team* t);
+	void swapTeams();
 	
 	// Slot modifiers
-	Slot* getAssignedSlot() const{ return assignedSlot; }
-	void setAssignedSlot(Slot* newSlot) { assignedSlot = newSlot; }
+	Slot* getAssignedSlot() const;
+	void setAssignedSlot(Slot* newSlot);
 
-	// modus modifiers
-	bool getNoHome() const{ return noHome; }
-	void setNoHome(const bool newMod) { noHome = newMod; } 
+	// modus modifiers: noHome is true if the home advantage is undetermined. False if the first team is the home team,
+	// and the second team is the away team.
+	bool getNoHome() const;
+	void setNoHome(const bool newMod);
 
 private:
-	Team* team1;			// First team
-	Team* team2;			// Second team
-	bool noHome;			// True if the home advantage is undetermined. False if t1 is the home team, and t2 is the away team.
-	Slot* assignedSlot = NULL; 	// Date of play: initially no meeting is scheduled yet
+	MeetingStore* store;
+	int index;
 };
 
 // Comparator functions
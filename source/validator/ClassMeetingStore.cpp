@@ -0,0 +1,61 @@
+#include "ClassMeetingStore.h"
+
+// Include std
+#include <algorithm>
+
+thread_local std::shared_ptr<ScheduleState> MeetingStore::bound;
+
+int MeetingStore::add(Team* t1, Team* t2, const bool mode, Slot* s){
+	const int i = noHome.size();
+	ScheduleState& st = changeState();
+	st.first.push_back(t1);
+	st.second.push_back(t2);
+	st.slot.push_back(s);
+	noHome.push_back(mode);
+	origFirst.push_back(t1);
+	origSecond.push_back(t2);
+	origSlot.push_back(s);
+	origNoHome.push_back(mode);
+	handles.push_back(Meeting(this, i));
+	return i;
+}
+
+void MeetingStore::clear(){
+	own = std::make_shared<ScheduleState>(this);
+	noHome.clear();
+	origFirst.clear();
+	origSecond.clear();
+	origSlot.clear();
+	origNoHome.clear();
+	handles.clear();
+}
+
+MeetingList MeetingStore::getAll(){
+	MeetingList all;
+	for (auto& m : handles) { all.push_back(&m); }
+	return all;
+}
+
+void MeetingStore::clearSlots(){
+	ScheduleState& st = changeState();
+	std::fill(st.slot.begin(), st.slot.end(), (Slot*) NULL);
+}
+
+void MeetingStore::resetSchedule(){
+	ScheduleState& st = changeState();
+	st.first = origFirst;
+	st.second = origSecond;
+	st.slot = origSlot;
+	noHome = origNoHome;
+}
+
+ScheduleState& MeetingStore::changeState(){
+	std::shared_ptr<ScheduleState>& s = currentState();
+	if (s.use_count() > 1) { s = s->cloneSchedule(); }
+	s->version = ScheduleState::nextVersion();
+	return *s;
+}
+
+std::shared_ptr<ScheduleState> MeetingStore::shareState(){
+	return currentState();
+}
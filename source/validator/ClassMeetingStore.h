@@ -0,0 +1,86 @@
+/*********************************************************************************************************
+MeetingStore class stores all meetings of the instance as parallel arrays, indexed by meeting
+	first/second:	first (home) and second (away) team
+	slot:		assigned slot, or NULL if the meeting is not scheduled yet
+	noHome:		true if the home advantage is undetermined
+The meeting queries scan the arrays sequentially. A Meeting handle per index is kept for the callers that
+work with Meeting pointers; handles stay valid until the store is cleared. The meetings as they were added are
+kept as well, such that the store can be reset to them when the next solution is read.
+The teams and slots that change with the schedule are kept in a ScheduleState: the state bound to the calling
+thread, or otherwise the own state of the store. Changes of the schedule clone the state first if it is shared,
+writes to its cache do not.
+*********************************************************************************************************/
+#ifndef CLASSMEETINGSTORE_H
+#define CLASSMEETINGSTORE_H
+
+// Include std
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Include other
+#include "Globals.h"
+#include "ClassMeeting.h"
+#include "ClassScheduleState.h"
+
+class MeetingStore
+{
+public:
+	MeetingStore() : own(std::make_shared<ScheduleState>(this)) {}
+	~MeetingStore() {}
+	MeetingStore(const MeetingStore&) = delete;
+	MeetingStore& operator=(const MeetingStore&) = delete;
+
+	// Add a meeting, and return its index
+	int add(Team* t1, Team* t2, const bool noHome, Slot* s);
+	int size() const { return noHome.size(); }
+	void clear();
+
+	// Handle of the meeting with index i, and all handles in order of index
+	Meeting* get(const int i) { return &handles[i]; }
+	MeetingList getAll();
+
+	Team* getFirstTeam(const int i) const { return getState().first[i]; }
+	Team* getSecondTeam(const int i) const { return getState().second[i]; }
+	Slot* getAssignedSlot(const int i) const { return getState().slot[i]; }
+	bool getNoHome(const int i) const { return noHome[i]; }
+
+	void setFirstTeam(const int i, Team* t) { changeState().first[i] = t; }
+	void setSecondTeam(const int i, Team* t) { changeState().second[i] = t; }
+	void swapTeams(const int i) { ScheduleState& st = changeState(); std::swap(st.first[i], st.second[i]); }
+	void setAssignedSlot(const int i, Slot* s) { changeState().slot[i] = s; }
+	void setNoHome(const int i, const bool mode) { noHome[i] = mode; }
+
+	// Schedule state of the calling thread
+	const ScheduleState& getState() const { return (bound && bound->owner == this) ? *bound : *own; }
+	// Cache of the state of the calling thread, written in place
+	ScheduleCache& getCache() const { return getState().cache; }
+	// The state of the calling thread for a change of the schedule, cloned first if it is shared
+	ScheduleState& changeState();
+	// Snapshot of the state of the calling thread, which is cloned when either copy is written
+	std::shared_ptr<ScheduleState> shareState();
+	// Replace the own state of the store
+	void setState(std::shared_ptr<ScheduleState> s) { own = s; }
+	// Bind a state to the calling thread, or unbind it if s is NULL
+	static void bindState(std::shared_ptr<ScheduleState> s) { bound = s; }
+
+	// Unschedule all meetings
+	void clearSlots();
+	// Restore all meetings as they were added: teams, home advantage, and slots fixed by the instance
+	void resetSchedule();
+
+private:
+	// The state that getState returns
+	std::shared_ptr<ScheduleState>& currentState() { return (bound && bound->owner == this) ? bound : own; }
+
+	std::shared_ptr<ScheduleState> own;
+	static thread_local std::shared_ptr<ScheduleState> bound;
+	std::vector<char> noHome;
+	std::vector<Team*> origFirst; 		// Meetings as added
+	std::vector<Team*> origSecond;
+	std::vector<Slot*> origSlot;
+	std::vector<char> origNoHome;
+	std::deque<Meeting> handles; 		// Deque: handles do not move when meetings are added
+};
+
+#endif /* CLASSMEETINGSTORE_H */
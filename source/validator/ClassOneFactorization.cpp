@@ -0,0 +1,80 @@
+#include "ClassOneFactorization.h"
+
+// Include std
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+OneFactorization::OneFactorization(const int nrTeams) : nrTeams(nrTeams), nrRounds(nrTeams - 1), opponent(nrTeams*(nrTeams - 1), -1),
+	teamLabel(nrTeams), roundLabel(nrTeams - 1)
+{
+	// nrTeams = 2n must be even
+	assert(nrTeams >= 2 && nrTeams%2 == 0);
+	cycle.reserve(nrTeams);
+}
+
+void OneFactorization::generate(std::default_random_engine& engine, int nrSwaps){
+	if (nrSwaps < 0) { nrSwaps = nrTeams; }
+
+	// Circle method with relabeled teams and rounds: in round r the last team meets team r,
+	// and team r+k meets team r-k (modulo nrRounds) for k = 1, ..., n-1
+	std::iota(teamLabel.begin(), teamLabel.end(), 0);
+	std::iota(roundLabel.begin(), roundLabel.end(), 0);
+	std::shuffle(teamLabel.begin(), teamLabel.end(), engine);
+	std::shuffle(roundLabel.begin(), roundLabel.end(), engine);
+	for (int r = 0; r < nrRounds; ++r) {
+		int* games = &opponent[roundLabel[r]*nrTeams];
+		int i = teamLabel[r];
+		int j = teamLabel[nrTeams - 1];
+		games[i] = j;
+		games[j] = i;
+		for (int k = 1; k < nrTeams/2; ++k) {
+			i = teamLabel[(r + k < nrRounds) ? r + k : r + k - nrRounds];
+			j = teamLabel[(r >= k) ? r - k : r - k + nrRounds];
+			games[i] = j;
+			games[j] = i;
+		}
+	}
+
+	// Kempe swaps between two random rounds, starting from a random team
+	if (nrRounds < 2) { return; }
+	std::uniform_int_distribution<int> randTeam(0, nrTeams - 1);
+	std::uniform_int_distribution<int> randRound(0, nrRounds - 1);
+	std::uniform_int_distribution<int> randOtherRound(0, nrRounds - 2);
+	for (int i = 0; i < nrSwaps; ++i) {
+		const int t = randTeam(engine);
+		const int r1 = randRound(engine);
+		int r2 = randOtherRound(engine);
+		if (r2 >= r1) { ++r2; }
+		kempeSwap(t, r1, r2);
+	}
+}
+
+void OneFactorization::kempeSwap(const int t, const int r1, const int r2){
+	// Follow the cycle: the game of round r1, then the game of round r2, until we are back at team t
+	int* games1 = &opponent[r1*nrTeams];
+	int* games2 = &opponent[r2*nrTeams];
+	cycle.clear();
+	int v = t;
+	do {
+		const int u = games1[v];
+		cycle.push_back(v);
+		cycle.push_back(u);
+		v = games2[u];
+	} while (v != t);
+
+	// The cycle is closed under the games of both rounds, such that both rounds remain a perfect matching
+	for (const int w : cycle) {
+		std::swap(games1[w], games2[w]);
+	}
+}
+
+std::vector<std::vector<int>> OneFactorization::getOpponentSchedule() const {
+	std::vector<std::vector<int>> opponentSchedule(nrTeams, std::vector<int>(nrRounds));
+	for (int r = 0; r < nrRounds; ++r) {
+		for (int t = 0; t < nrTeams; ++t) {
+			opponentSchedule[t][r] = opponent[r*nrTeams + t];
+		}
+	}
+	return opponentSchedule;
+}
@@ -0,0 +1,46 @@
+/*********************************************************************************************************
+OneFactorization class generates random single round robin opponent schedules of an even number of teams
+	opponent[r][t]: opponent of team t in round r, stored as a flat nrRounds x nrTeams array, such that the
+			games of a round are contiguous
+A schedule starts from the circle method, whose teams and rounds are relabeled at random, and is then perturbed
+by random Kempe swaps: the games of two rounds form disjoint cycles that alternate between the rounds, and moving
+all games of one cycle to the other round gives another 1-factorization. Relabeling alone only gives schedules
+isomorphic to the circle method.
+All randomness is drawn from the given engine, such that a seed gives the same schedule. The arrays are kept
+between calls, such that generating many schedules of the same size does not allocate.
+*********************************************************************************************************/
+#ifndef CLASSONEFACTORIZATION_H
+#define CLASSONEFACTORIZATION_H
+
+// Include std
+#include <random>
+#include <vector>
+
+class OneFactorization
+{
+public:
+	OneFactorization(const int nrTeams);
+	~OneFactorization() {}
+
+	// Generate a random schedule with nrSwaps Kempe swaps, by default one per team
+	void generate(std::default_random_engine& engine, int nrSwaps = -1);
+
+	int getNrTeams() const { return nrTeams; }
+	int getNrRounds() const { return nrRounds; }
+	int getOpponent(const int t, const int r) const { return opponent[r*nrTeams + t]; }
+	// Opponent schedule as in Interface::canonicalPattern: one row of opponents per team
+	std::vector<std::vector<int>> getOpponentSchedule() const;
+
+private:
+	// Move the games of the cycle through team t that alternates between rounds r1 and r2 to the other round
+	void kempeSwap(const int t, const int r1, const int r2);
+
+	int nrTeams;
+	int nrRounds;
+	std::vector<int> opponent; 		// nrRounds x nrTeams
+	std::vector<int> teamLabel; 		// Random relabeling of the teams of the circle method
+	std::vector<int> roundLabel; 		// Random relabeling of the rounds of the circle method
+	std::vector<int> cycle; 		// Teams of the cycle of a Kempe swap
+};
+
+#endif /* CLASSONEFACTORIZATION_H */
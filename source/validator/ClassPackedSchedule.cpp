@@ -0,0 +1,275 @@
+#include "ClassPackedSchedule.h"
+
+// Include other
+#include "ClassMeetingStore.h"
+#include "ClassSlot.h"
+#include "ClassTeam.h"
+
+// Ids of a map are contiguous if they run from 0 to size-1
+template <typename T>
+static bool isContiguous(const std::map<int, T>& map){
+	return map.empty() || (map.begin()->first == 0 && map.rbegin()->first == (int) map.size() - 1);
+}
+
+void PackedSchedule::build(const MeetingStore& meetings, const TeamMap& teams, const SlotMap& slots){
+	nrTeams = teams.size();
+	nrSlots = slots.size();
+	nrWords = (nrSlots + 63) / 64;
+	opponent.assign(nrTeams*nrSlots, -1);
+	home.assign(nrTeams*nrWords, 0);
+	plays.assign(nrTeams*nrWords, 0);
+
+	valid = isContiguous(teams) && isContiguous(slots);
+	boards = valid && nrTeams <= maxBoardTeams;
+	for (int m = H; m <= A; ++m) { board[m].assign(boards ? nrSlots*nrTeams : 0, 0); }
+	pairs.assign(boards ? nrTeams*nrTeams*nrWords : 0, 0);
+	if (!valid) { return; }
+
+	for (int i = 0; i < meetings.size(); ++i) {
+		if (meetings.getAssignedSlot(i) == NULL) { continue; }
+		const int h = meetings.getFirstTeam(i)->getId();
+		const int a = meetings.getSecondTeam(i)->getId();
+		const int s = meetings.getAssignedSlot(i)->getId();
+		if (h < 0 || h >= nrTeams || a < 0 || a >= nrTeams || s < 0 || s >= nrSlots || h == a
+			|| opponent[h*nrSlots + s] != -1 || opponent[a*nrSlots + s] != -1) {
+			valid = boards = false;
+			return;
+		}
+		opponent[h*nrSlots + s] = a;
+		opponent[a*nrSlots + s] = h;
+		const uint64_t bit = (uint64_t) 1 << (s%64);
+		home[h*nrWords + s/64] |= bit;
+		plays[h*nrWords + s/64] |= bit;
+		plays[a*nrWords + s/64] |= bit;
+		if (boards) {
+			board[H][s*nrTeams + h] = (TeamMask) 1 << a;
+			board[A][s*nrTeams + a] = (TeamMask) 1 << h;
+			pairs[(h*nrTeams + a)*nrWords + s/64] |= bit;
+		}
+	}
+
+	for (int m = H; m <= HA; ++m) { prefix[m].assign(nrTeams*(nrSlots + 1), 0); }
+	for (int t = 0; t < nrTeams; ++t) {
+		for (int s = 0; s < nrSlots; ++s) {
+			const int i = t*(nrSlots + 1) + s;
+			const bool game = opponent[t*nrSlots + s] != -1;
+			const bool isHome = game && ((home[t*nrWords + s/64] >> (s%64)) & 1);
+			prefix[H][i+1] = prefix[H][i] + isHome;
+			prefix[A][i+1] = prefix[A][i] + (game && !isHome);
+			prefix[HA][i+1] = prefix[HA][i] + game;
+		}
+	}
+}
+
+SlotMask PackedSchedule::slotMask(const SlotSet& slots) const{
+	SlotMask mask(nrWords, 0);
+	for (auto s : slots) {
+		const int id = s->getId();
+		if (id >= 0 && id < nrSlots) { mask[id/64] |= (uint64_t) 1 << (id%64); }
+	}
+	return mask;
+}
+
+TeamMask PackedSchedule::teamMask(const TeamSet& teams) const{
+	TeamMask mask = 0;
+	for (auto t : teams) {
+		const int id = t->getId();
+		if (id >= 0 && id < nrTeams) { mask |= (TeamMask) 1 << id; }
+	}
+	return mask;
+}
+
+bool PackedSchedule::playsConsecutively(const int t) const{
+	// Count the runs of consecutive slots in which the team plays
+	const uint64_t* p = getPlaysRow(t);
+	int runs = 0;
+	uint64_t carry = 0;
+	for (int w = 0; w < nrWords; ++w) {
+		runs += __builtin_popcountll(p[w] & ~((p[w] << 1) | carry));
+		carry = p[w] >> 63;
+	}
+	return runs <= 1;
+}
+
+void PackedSchedule::breakRow(const int t, const BreakMode bMode, const HomeMode mode, uint64_t* row) const{
+	const uint64_t* h = getHomeRow(t);
+	const uint64_t* p = getPlaysRow(t);
+
+	if (bMode == REGULAR || playsConsecutively(t)) {
+		// Compare every slot with the previous one, 64 slots at a time
+		uint64_t hCarry = 0, pCarry = 0;
+		for (int w = 0; w < nrWords; ++w) {
+			const uint64_t hPrev = (h[w] << 1) | hCarry;
+			const uint64_t pPrev = (p[w] << 1) | pCarry;
+			row[w] = ~(h[w] ^ hPrev) & p[w] & pPrev;
+			hCarry = h[w] >> 63;
+			pCarry = p[w] >> 63;
+		}
+	} else {
+		// Walk over the games in increasing slot, empty slots are skipped
+		int prev = -1;
+		for (int w = 0; w < nrWords; ++w) {
+			row[w] = 0;
+			for (uint64_t bits = p[w]; bits; bits &= bits - 1) {
+				const int b = __builtin_ctzll(bits);
+				const int home = (h[w] >> b) & 1;
+				if (home == prev) { row[w] |= (uint64_t) 1 << b; }
+				prev = home;
+			}
+		}
+	}
+
+	for (int w = 0; w < nrWords; ++w) {
+		if (mode == H) { row[w] &= h[w]; }
+		if (mode == A) { row[w] &= ~h[w]; }
+	}
+}
+
+int PackedSchedule::breaks(const int t, const BreakMode bMode, const HomeMode mode, const uint64_t* mask) const{
+	SlotMask row(nrWords);
+	breakRow(t, bMode, mode, row.data());
+	int br = 0;
+	for (int w = 0; w < nrWords; ++w) {
+		br += __builtin_popcountll(mask ? row[w] & mask[w] : row[w]);
+	}
+	return br;
+}
+
+std::vector<int> PackedSchedule::breakRuns(const int t, const BreakMode bMode, const HomeMode mode) const{
+	SlotMask row(nrWords);
+	breakRow(t, bMode, mode, row.data());
+	const uint64_t* p = getPlaysRow(t);
+	std::vector<int> runs;
+	int run = 0;
+	for (int w = 0; w < nrWords; ++w) {
+		for (uint64_t bits = p[w]; bits; bits &= bits - 1) {
+			if ((row[w] >> __builtin_ctzll(bits)) & 1) {
+				run++;
+			} else if (run > 0) {
+				runs.push_back(run);
+				run = 0;
+			}
+		}
+	}
+	if (run > 0) { runs.push_back(run); }
+	return runs;
+}
+
+// Popcount of the home (H), away (A), or all (HA) games of a team, templated such that the words are counted without
+// testing the mode
+template <HomeMode mode>
+static int countGames(const uint64_t* h, const uint64_t* p, const int nrWords){
+	int nr = 0;
+	for (int w = 0; w < nrWords; ++w) {
+		nr += __builtin_popcountll(mode == H ? h[w] : (mode == A ? p[w] & ~h[w] : p[w]));
+	}
+	return nr;
+}
+
+int PackedSchedule::nrGames(const int t, const HomeMode mode) const{
+	switch (mode) {
+		case H:	return countGames<H>(getHomeRow(t), getPlaysRow(t), nrWords);
+		case A:	return countGames<A>(getHomeRow(t), getPlaysRow(t), nrWords);
+		default: return countGames<HA>(getHomeRow(t), getPlaysRow(t), nrWords);
+	}
+}
+
+void PackedSchedule::balance(const int t, const SlotMask& mask, int& maxDifference, int& maxSlot) const{
+	// Running difference: one after the first game, reset to zero when the home advantage changes,
+	// and increased by one for every further game with the same home advantage
+	const uint64_t* h = getHomeRow(t);
+	const uint64_t* p = getPlaysRow(t);
+	maxDifference = -1;
+	maxSlot = -1;
+	int difference = 0, prev = -1;
+	for (int w = 0; w < nrWords; ++w) {
+		for (uint64_t bits = p[w]; bits; bits &= bits - 1) {
+			const int b = __builtin_ctzll(bits);
+			const int home = (h[w] >> b) & 1;
+			if (prev < 0) {
+				difference = 1;
+			} else if (home != prev) {
+				difference = 0;
+			} else {
+				difference++;
+				if (difference > maxDifference && ((mask[w] >> b) & 1)) {
+					maxDifference = difference;
+					maxSlot = w*64 + b;
+				}
+			}
+			prev = home;
+		}
+	}
+}
+
+bool PackedSchedule::distance(const int t, const DenseTable& dist, const uint64_t* mask, int& value) const{
+	// Collect the venues of all games in increasing slot, starting and ending at home. The trip to a game
+	// belongs to the slot of that game, the trip back home to the slot of the last game.
+	std::vector<int> venues(1, t), tripSlots;
+	const int* opp = &opponent[t*nrSlots];
+	for (int s = 0; s < nrSlots; ++s) {
+		if (opp[s] < 0) { continue; }
+		venues.push_back(isHome(t, s) ? t : opp[s]);
+		tripSlots.push_back(s);
+	}
+	value = 0;
+	if (tripSlots.empty()) { return true; }
+	venues.push_back(t);
+	tripSlots.push_back(tripSlots.back());
+
+	// Sum the distances between consecutive venues
+	for (size_t i = 0; i < tripSlots.size(); ++i) {
+		const int s = tripSlots[i];
+		if (mask && !((mask[s/64] >> (s%64)) & 1)) { continue; }
+		const int idx = venues[i]*nrTeams + venues[i+1];
+		if (!dist.isSet[idx]) { return false; }
+		value += dist.values[idx];
+	}
+	return true;
+}
+
+bool PackedSchedule::cost(const int t, const DenseTable& costs, int& value) const{
+	// Sum the costs of all home games
+	value = 0;
+	const uint64_t* h = getHomeRow(t);
+	for (int w = 0; w < nrWords; ++w) {
+		for (uint64_t bits = h[w]; bits; bits &= bits - 1) {
+			const int s = w*64 + __builtin_ctzll(bits);
+			const int idx = (t*nrTeams + getOpponent(t, s))*nrSlots + s;
+			if (!costs.isSet[idx]) { return false; }
+			value += costs.values[idx];
+		}
+	}
+	return true;
+}
+
+bool PackedSchedule::carryOver(const std::vector<int>& members, const DenseTable& weights, int& value) const{
+	// The carry-over effects matrix is indexed by team id, and has a row for every member of the league
+	const int nrRows = members.size();
+	if (nrRows > nrTeams) { return false; }
+	std::vector<int> COM(nrRows*nrRows, 0);
+
+	// Opponent o1 gives a carry-over to the next opponent o2, the last opponent to the first one
+	for (auto t : members) {
+		const int* opp = &opponent[t*nrSlots];
+		int first = -1, prev = -1;
+		for (int s = 0; s < nrSlots; ++s) {
+			if (opp[s] < 0) { continue; }
+			if (opp[s] >= nrRows) { return false; }
+			if (first < 0) { first = opp[s]; }
+			else { COM[prev*nrRows + opp[s]]++; }
+			prev = opp[s];
+		}
+		if (first >= 0) { COM[prev*nrRows + first]++; }
+	}
+
+	value = 0;
+	for (int i = 0; i < nrRows; ++i) {
+		for (int j = 0; j < nrRows; ++j) {
+			const int c = COM[i*nrRows + j];
+			const int idx = i*nrTeams + j;
+			value += (weights.isSet[idx] ? weights.values[idx] : 1)*c*c;
+		}
+	}
+	return true;
+}
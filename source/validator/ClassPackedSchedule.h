@@ -0,0 +1,114 @@
+/*********************************************************************************************************
+PackedSchedule class stores the timetable as a dense team x slot matrix
+	opponent[t][s]: opponent of team t in slot s, or -1 if t does not play in s
+	home/plays: one bit row per team over all slots, packed in 64-bit words
+	prefix: number of home, away, and all games of every team before each slot, such that the games in a range of
+	slots are a subtraction
+	board: for leagues of at most 64 teams, one bit row of opponents per slot and team, separately for home and
+	away games, and one slot row per ordered pair of teams, such that team sets become 64-bit masks
+The matrix is rebuilt from the meeting list whenever the schedule changes, and is only valid if team ids
+run from 0 to |T|-1, slot ids from 0 to |S|-1, and no team plays more than once in a slot. Otherwise, the
+caller falls back to walking the meeting lists.
+*********************************************************************************************************/
+#ifndef CLASSPACKEDSCHEDULE_H
+#define CLASSPACKEDSCHEDULE_H
+
+// Include std
+#include <vector>
+#include <cstdint>
+
+// Include other
+#include "Globals.h"
+
+class MeetingStore;
+
+// One bit per slot id, packed in 64-bit words
+typedef std::vector<uint64_t> SlotMask;
+// One bit per team id, for leagues with at most 64 teams
+typedef uint64_t TeamMask;
+
+// Dense copy of a distance, weight, or cost map, indexed by ids
+struct DenseTable
+{
+	std::vector<int> values;
+	std::vector<char> isSet; 		// False if the map has no entry for this index
+	bool built = false;
+};
+
+class PackedSchedule
+{
+public:
+	PackedSchedule() {}
+	~PackedSchedule() {}
+
+	// Rebuild the matrix from all scheduled meetings
+	void build(const MeetingStore& meetings, const TeamMap& teams, const SlotMap& slots);
+	bool isValid() const { return valid; }
+
+	int getNrTeams() const { return nrTeams; }
+	int getNrSlots() const { return nrSlots; }
+	int getNrWords() const { return nrWords; }
+	int getOpponent(const int t, const int s) const { return opponent[t*nrSlots + s]; }
+	bool isHome(const int t, const int s) const { return (home[t*nrWords + s/64] >> (s%64)) & 1; }
+	const uint64_t* getHomeRow(const int t) const { return &home[t*nrWords]; }
+	const uint64_t* getPlaysRow(const int t) const { return &plays[t*nrWords]; }
+	SlotMask slotMask(const SlotSet& slots) const;
+
+	// Bitboards, only built if there are at most maxBoardTeams teams
+	static const int maxBoardTeams = 64;
+	bool hasBoards() const { return boards; }
+	TeamMask teamMask(const TeamSet& teams) const;
+	// Opponents of team t in slot s in a home (H), away (A), or any (HA) game
+	template <HomeMode mode>
+	TeamMask boardRow(const int t, const int s) const {
+		const int i = s*nrTeams + t;
+		return mode == H ? board[H][i] : (mode == A ? board[A][i] : board[H][i] | board[A][i]);
+	}
+	// Slots in which team h hosts team a
+	const uint64_t* getPairRow(const int h, const int a) const { return &pairs[(h*nrTeams + a)*nrWords]; }
+
+	// Bit row of the breaks of a team: bit s is set if the game in slot s has home mode mode, and the same
+	// home advantage as the game in slot s-1 (REGULAR) or as the previous game of the team (GENERALIZED)
+	void breakRow(const int t, const BreakMode bMode, const HomeMode mode, uint64_t* row) const;
+
+	// Number of breaks of a team in the slots of the mask, or in all slots if mask is NULL
+	int breaks(const int t) const { return breaks(t, GENERALIZED, HA, NULL); }
+	int breaks(const int t, const BreakMode bMode, const HomeMode mode, const uint64_t* mask) const;
+
+	// Lengths of the runs of breaks in consecutive games of a team
+	std::vector<int> breakRuns(const int t, const BreakMode bMode, const HomeMode mode) const;
+
+	// Number of home (H), away (A), or all (HA) games of a team
+	int nrGames(const int t, const HomeMode mode) const;
+	// Number of home (H), away (A), or all (HA) games of a team in the slots first..last
+	int nrGames(const int t, const HomeMode mode, const int first, const int last) const {
+		const int* row = &prefix[mode][t*(nrSlots + 1)];
+		return row[last + 1] - row[first];
+	}
+
+	// Largest home/away difference (as in FA1) of a team over the slots in the mask, -1 if there is none
+	void balance(const int t, const SlotMask& mask, int& maxDifference, int& maxSlot) const;
+
+	// Objective kernels: return false if an entry of the data table is missing
+	bool distance(const int t, const DenseTable& dist, const uint64_t* mask, int& value) const;
+	bool cost(const int t, const DenseTable& costs, int& value) const;
+	bool carryOver(const std::vector<int>& members, const DenseTable& weights, int& value) const;
+
+private:
+	// True if the team plays in all slots between its first and last game
+	bool playsConsecutively(const int t) const;
+
+	bool valid = false;
+	int nrTeams = 0;
+	int nrSlots = 0;
+	int nrWords = 0; 			// Number of 64-bit words in a bit row
+	std::vector<int> opponent; 		// nrTeams x nrSlots
+	std::vector<uint64_t> home; 		// nrTeams x nrWords: bit s set if home game in slot s
+	std::vector<uint64_t> plays; 		// nrTeams x nrWords: bit s set if game in slot s
+	std::vector<int> prefix[3]; 		// Per home mode H, A, HA: nrTeams x (nrSlots+1) games before slot s
+	bool boards = false;
+	std::vector<TeamMask> board[2]; 	// Per home mode H, A: nrSlots x nrTeams opponents of team t in slot s
+	std::vector<uint64_t> pairs; 		// nrTeams x nrTeams x nrWords: bit s set if h hosts a in slot s
+};
+
+#endif /* CLASSPACKEDSCHEDULE_H */
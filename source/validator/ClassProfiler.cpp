@@ -0,0 +1,139 @@
+#include "ClassProfiler.h"
+
+// Include std
+#include <algorithm>
+#include <iomanip>
+
+// Include other
+#include "ClassConstraint.h"
+
+// Number of individual constraints listed in the text report
+#define NR_SLOWEST 10
+
+// Allocating and initializing Profiler static data member.
+Profiler *Profiler::iProfiler = 0;
+
+Profiler::Phase::Phase(const std::string name) : name(name), span(name, "phase") {
+	if (Profiler::get()->isEnabled()) { start = Clock::now(); }
+}
+
+Profiler::Phase::~Phase(){
+	if (Profiler::get()->isEnabled()) { Profiler::get()->addPhase(name, elapsed(start)); }
+}
+
+void Profiler::addPhase(const std::string name, const double seconds){
+	if (!phases.count(name)) {
+		phaseOrder.push_back(name);
+		phases[name].name = name;
+	}
+	Entry& e = phases[name];
+	e.calls++;
+	e.seconds += seconds;
+}
+
+void Profiler::addConstraint(const Constraint* c, const double seconds, const ObjCost cost, const long meetingsScanned){
+	if (!constraints.count(c)) {
+		constraintOrder.push_back(c);
+		constraints[c].name = c->getName();
+	}
+	Entry& e = constraints[c];
+	e.calls++;
+	e.violations += (cost.first != 0 || cost.second != 0);
+	e.meetingsScanned += meetingsScanned;
+	e.seconds += seconds;
+}
+
+// Position of every constraint in the constraint list of the instance: the numbering of all reports.
+// The base constraints are not in the list, and get -1.
+static std::map<const Constraint*, int> instanceIndex(){
+	std::map<const Constraint*, int> index;
+	int i = 0;
+	for (auto c : Instance::get()->getCnstrs()) { index[c] = i++; }
+	return index;
+}
+
+static int getIndex(const std::map<const Constraint*, int>& index, const Constraint* c){
+	auto it = index.find(c);
+	return (it != index.end()) ? it->second : -1;
+}
+
+std::vector<Profiler::Entry> Profiler::typeEntries() const{
+	// Aggregate over all constraints with the same name, sorted by decreasing time
+	std::map<std::string, Entry> types;
+	for (auto c : constraints) {
+		Entry& e = types[c.second.name];
+		e.name = c.second.name;
+		e.calls += c.second.calls;
+		e.violations += c.second.violations;
+		e.meetingsScanned += c.second.meetingsScanned;
+		e.seconds += c.second.seconds;
+	}
+	std::vector<Entry> entries;
+	for (auto t : types) { entries.push_back(t.second); }
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& e1, const Entry& e2) { return e1.seconds > e2.seconds; });
+	return entries;
+}
+
+void Profiler::print(std::ostream& out) const{
+	const std::string line = "       -------------------------------------------------------------------";
+	out << std::left << std::setw(30) << "       Phase" << std::setw(10) << "Calls" << "Time (ms)" << std::endl;
+	for (auto p : phaseOrder) {
+		const Entry& e = phases.at(p);
+		out << std::setw(30) << "       " + e.name << std::setw(10) << e.calls << std::fixed << std::setprecision(3) << 1000*e.seconds << std::endl;
+	}
+
+	out << line << std::endl;
+	out << std::setw(20) << "       Type" << std::setw(10) << "Calls" << std::setw(12) << "Violations" << std::setw(18) << "Meetings scanned" << "Time (ms)" << std::endl;
+	for (auto e : typeEntries()) {
+		out << std::setw(20) << "       " + e.name << std::setw(10) << e.calls << std::setw(12) << e.violations << std::setw(18) << e.meetingsScanned << 1000*e.seconds << std::endl;
+	}
+
+	// Slowest individual constraints, numbered by their position in the instance
+	const std::map<const Constraint*, int> index = instanceIndex();
+	std::vector<int> order;
+	for (int i = 0; i < (int) constraintOrder.size(); ++i) { order.push_back(i); }
+	std::stable_sort(order.begin(), order.end(), [this](const int i, const int j) {
+		return constraints.at(constraintOrder[i]).seconds > constraints.at(constraintOrder[j]).seconds;
+	});
+	if (order.size() > NR_SLOWEST) { order.resize(NR_SLOWEST); }
+
+	out << line << std::endl;
+	out << std::setw(20) << "       Constraint" << std::setw(10) << "Calls" << std::setw(12) << "Violations" << std::setw(18) << "Meetings scanned" << "Time (ms)" << std::endl;
+	for (auto i : order) {
+		const Entry& e = constraints.at(constraintOrder[i]);
+		const int nr = getIndex(index, constraintOrder[i]);
+		out << std::setw(20) << "       " + e.name + (nr >= 0 ? " #" + std::to_string(nr) : " base") << std::setw(10) << e.calls << std::setw(12) << e.violations << std::setw(18) << e.meetingsScanned << 1000*e.seconds << std::endl;
+	}
+	out << line << std::right << std::defaultfloat << std::endl;
+}
+
+// Write the fields of an entry as JSON members
+static void printJsonEntry(std::ostream& out, const Profiler::Entry& e){
+	out << "\"name\": \"" << e.name << "\", \"calls\": " << e.calls << ", \"violations\": " << e.violations
+		<< ", \"meetingsScanned\": " << e.meetingsScanned << ", \"seconds\": " << e.seconds;
+}
+
+void Profiler::printJson(std::ostream& out) const{
+	out << std::setprecision(9) << "{\n  \"phases\": [";
+	for (int i = 0; i < (int) phaseOrder.size(); ++i) {
+		const Entry& e = phases.at(phaseOrder[i]);
+		out << (i ? ",\n" : "\n") << "    {\"name\": \"" << e.name << "\", \"calls\": " << e.calls << ", \"seconds\": " << e.seconds << "}";
+	}
+
+	out << "\n  ],\n  \"types\": [";
+	const std::vector<Entry> types = typeEntries();
+	for (int i = 0; i < (int) types.size(); ++i) {
+		out << (i ? ",\n" : "\n") << "    {";
+		printJsonEntry(out, types[i]);
+		out << "}";
+	}
+
+	out << "\n  ],\n  \"constraints\": [";
+	const std::map<const Constraint*, int> index = instanceIndex();
+	for (int i = 0; i < (int) constraintOrder.size(); ++i) {
+		out << (i ? ",\n" : "\n") << "    {\"index\": " << getIndex(index, constraintOrder[i]) << ", ";
+		printJsonEntry(out, constraints.at(constraintOrder[i]));
+		out << "}";
+	}
+	out << "\n  ]\n}" << std::endl;
+}
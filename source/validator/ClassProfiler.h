@@ -0,0 +1,85 @@
+/*********************************************************************************************************
+Profiler class collects timings of a validation, implemented via the singleton pattern
+	Phases:		wall time spent parsing, generating meetings, checking symmetry, and calculating the
+			objective. Parsing includes the generation of meetings.
+	Constraints:	wall time, number of calls, number of violated calls, and number of meetings scanned by
+			the meeting queries of the Instance class, per constraint and aggregated per type.
+Constraints are numbered by their position in the constraint list of the instance, as in the query report of the
+Instance class; the base constraints BA1 and BA2 are not in the list, and have index -1.
+Timings are only taken once the profiler is enabled, with -profile or -profileJson.
+*********************************************************************************************************/
+#ifndef CLASSPROFILER_H
+#define CLASSPROFILER_H
+
+// Include std
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Include other
+#include "Globals.h"
+#include "ClassTracer.h"
+
+class Profiler
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	// Statistics of a single constraint, or of all constraints of one type
+	struct Entry {
+		std::string name;
+		long calls = 0;
+		long violations = 0; 			// Number of calls with a non-zero cost
+		long meetingsScanned = 0;
+		double seconds = 0;
+	};
+
+	// Scoped timer: adds the elapsed time to a phase when it goes out of scope, and traces it as a span
+	class Phase
+	{
+	public:
+		Phase(const std::string name);
+		~Phase();
+	private:
+		std::string name;
+		Clock::time_point start;
+		Tracer::Span span;
+	};
+
+	// Singleton pattern: public static accessor
+	static Profiler* get() {
+		if (!iProfiler) { iProfiler = new Profiler; }
+		return iProfiler;
+	}
+
+	void setEnabled(const bool e) { enabled = e; }
+	bool isEnabled() const { return enabled; }
+
+	// Record statistics
+	void addPhase(const std::string name, const double seconds);
+	void addConstraint(const Constraint* c, const double seconds, const ObjCost cost, const long meetingsScanned);
+	static double elapsed(const Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+	// Report on all recorded statistics
+	void print(std::ostream& out) const;
+	void printJson(std::ostream& out) const;
+
+private:
+	// constructor
+	Profiler() {}
+	~Profiler() {}
+
+	std::vector<Entry> typeEntries() const;
+
+	static Profiler* iProfiler;
+
+	bool enabled = false;
+	std::vector<std::string> phaseOrder; 			// Phases in order of first occurrence
+	std::map<std::string, Entry> phases;
+	std::vector<const Constraint*> constraintOrder; 	// Constraints in order of first evaluation
+	std::map<const Constraint*, Entry> constraints;
+};
+
+#endif /* CLASSPROFILER_H */
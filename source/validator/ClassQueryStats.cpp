@@ -0,0 +1,52 @@
+#include "ClassQueryStats.h"
+
+// Include std
+#include <iomanip>
+
+unsigned long QueryStats::getVisited() const{
+	unsigned long visited = 0;
+	for (int q = 0; q < (int) NRQUERIES; ++q) {
+		visited += counters[q].visited.load(std::memory_order_relaxed);
+	}
+	return visited;
+}
+
+void QueryStats::clear(){
+	for (int q = 0; q < (int) NRQUERIES; ++q) {
+		counters[q].calls.store(0, std::memory_order_relaxed);
+		counters[q].visited.store(0, std::memory_order_relaxed);
+		counters[q].returned.store(0, std::memory_order_relaxed);
+	}
+}
+
+std::string QueryStats::getName(const Query q){
+	switch (q) {
+		case ALL:		return "getMeetings";
+		case TEAM:		return "getMeetingsTeam";
+		case SLOT:		return "getMeetingsSlot";
+		case TEAMSLOT:		return "getMeetingsTeamSlot";
+		case TEAMTEAMSLOT:	return "getMeetingsTeamTeamSlot";
+		case TEAMTEAM:		return "getMeetingsTeamTeam";
+		case PACKED:		return "getPackedSchedule";
+		default:		return "unknown";
+	}
+}
+
+void QueryStats::print(std::ostream& out, const std::string label) const{
+	for (int q = 0; q < (int) NRQUERIES; ++q) {
+		const Counter& c = counters[q];
+		if (c.calls.load(std::memory_order_relaxed) == 0) { continue; }
+		out << std::left << std::setw(20) << "       " + label << std::setw(26) << getName((Query) q) << std::setw(10) << c.calls.load(std::memory_order_relaxed)
+			<< std::setw(12) << c.visited.load(std::memory_order_relaxed) << c.returned.load(std::memory_order_relaxed) << std::right << std::endl;
+	}
+}
+
+void QueryStats::printJson(std::ostream& out) const{
+	out << "{";
+	for (int q = 0; q < (int) NRQUERIES; ++q) {
+		const Counter& c = counters[q];
+		out << (q ? ", " : "") << "\"" << getName((Query) q) << "\": {\"calls\": " << c.calls.load(std::memory_order_relaxed)
+			<< ", \"visited\": " << c.visited.load(std::memory_order_relaxed) << ", \"returned\": " << c.returned.load(std::memory_order_relaxed) << "}";
+	}
+	out << "}";
+}
@@ -0,0 +1,53 @@
+/*********************************************************************************************************
+QueryStats class counts how often the meeting queries of the Instance class are called
+	Calls:		number of calls of the query
+	Visited:	number of meetings the query walked over
+	Returned:	number of meetings the query returned
+The counters are relaxed atomics, and are always kept: they are cheap enough to leave on, and let regressions
+in the number of visited meetings be tracked over time.
+*********************************************************************************************************/
+#ifndef CLASSQUERYSTATS_H
+#define CLASSQUERYSTATS_H
+
+// Include std
+#include <atomic>
+#include <iostream>
+#include <string>
+
+class QueryStats
+{
+public:
+	enum Query : unsigned int { ALL, TEAM, SLOT, TEAMSLOT, TEAMTEAMSLOT, TEAMTEAM, PACKED, NRQUERIES };
+
+	struct Counter {
+		std::atomic<unsigned long> calls{0};
+		std::atomic<unsigned long> visited{0};
+		std::atomic<unsigned long> returned{0};
+	};
+
+	QueryStats() {}
+	~QueryStats() {}
+
+	void add(const Query q, const unsigned long visited, const unsigned long returned) {
+		counters[q].calls.fetch_add(1, std::memory_order_relaxed);
+		counters[q].visited.fetch_add(visited, std::memory_order_relaxed);
+		counters[q].returned.fetch_add(returned, std::memory_order_relaxed);
+	}
+
+	const Counter& get(const Query q) const { return counters[q]; }
+	unsigned long getVisited() const; 	// Sum over all queries
+	void clear();
+
+	// Name of the Instance method behind a query
+	static std::string getName(const Query q);
+
+	// One line per query that was called, starting with the given label
+	void print(std::ostream& out, const std::string label) const;
+	// JSON object with the counters of every query
+	void printJson(std::ostream& out) const;
+
+private:
+	Counter counters[NRQUERIES];
+};
+
+#endif /* CLASSQUERYSTATS_H */
@@ -0,0 +1,12 @@
+#include "ClassScheduleState.h"
+
+std::atomic<unsigned long> ScheduleState::versionCounter(0);
+
+std::shared_ptr<ScheduleState> ScheduleState::cloneSchedule() const{
+	std::shared_ptr<ScheduleState> s = std::make_shared<ScheduleState>(owner);
+	s->version = version;
+	s->first = first;
+	s->second = second;
+	s->slot = slot;
+	return s;
+}
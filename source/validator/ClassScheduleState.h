@@ -0,0 +1,67 @@
+/*********************************************************************************************************
+ScheduleState class stores everything of the instance that depends on the schedule
+	first/second/slot:	home team, away team, and assigned slot of every meeting, indexed as in the MeetingStore
+	version:		stamp of the last change of the meetings
+	cache:			the packed schedule, the counts of every constraint batch, the deviation of every constraint,
+				and the cost that does not depend on the constraint list, each with the stamp it was calculated for
+States are shared copy-on-write: a snapshot of the schedule is a shared pointer, and the MeetingStore clones a
+shared state before changing its meetings. The clone starts with an empty cache, as the cache of the old schedule
+does not hold for the new one. The cache is written in place, by whoever evaluates the schedule, such that all
+holders of the state see it. All other data of the instance is not copied, such that many schedules can be
+evaluated in parallel against one instance, each bound to its own thread. A state may only be evaluated by one
+thread at a time.
+*********************************************************************************************************/
+#ifndef CLASSSCHEDULESTATE_H
+#define CLASSSCHEDULESTATE_H
+
+// Include std
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+// Include other
+#include "Globals.h"
+#include "ClassPackedSchedule.h"
+
+class Constraint;
+class MeetingStore;
+
+class ScheduleCache
+{
+public:
+	ScheduleCache() {}
+	~ScheduleCache() {}
+
+	PackedSchedule packed;
+	unsigned long packedVersion = -1;
+	std::vector<std::vector<int>> batchCounts; 	// Counts of every batch of the instance, see ConstraintBatch
+	std::vector<unsigned long> batchVersions;
+	std::map<const Constraint*, std::pair<int, unsigned long>> deviations; 	// Deviation of the last check, and its stamp
+	ObjCost fixedCost = std::make_pair(0,0);
+	unsigned long fixedVersion = -1;
+};
+
+class ScheduleState
+{
+public:
+	ScheduleState(const MeetingStore* owner) : owner(owner) {}
+	~ScheduleState() {}
+
+	// Stamp of a change of a schedule state or of the instance: increasing, and unique over all states
+	static unsigned long nextVersion() { return ++versionCounter; }
+	// Copy of the meetings, with an empty cache
+	std::shared_ptr<ScheduleState> cloneSchedule() const;
+
+	const MeetingStore* owner; 		// Store of the meetings that are indexed
+	unsigned long version = 0;
+	std::vector<Team*> first;
+	std::vector<Team*> second;
+	std::vector<Slot*> slot;
+	mutable ScheduleCache cache; 		// Not part of the schedule: written through const states
+
+private:
+	static std::atomic<unsigned long> versionCounter;
+};
+
+#endif /* CLASSSCHEDULESTATE_H */
@@ -0,0 +1,57 @@
+#include "ClassTracer.h"
+
+// Include std
+#include <atomic>
+
+// Include POSIX
+#include <unistd.h>
+
+// Allocating and initializing Tracer static data member.
+Tracer *Tracer::iTracer = 0;
+
+// Every thread gets its own lane, numbered in order of its first span
+static int threadLane(){
+	static std::atomic<int> nrLanes(0);
+	thread_local int lane = nrLanes++;
+	return lane;
+}
+
+// Escape a string for use in JSON
+static std::string escapeJson(const std::string& str){
+	std::string escaped;
+	for (auto c : str) {
+		if (c == '"' || c == '\\') { escaped += '\\'; }
+		escaped += c;
+	}
+	return escaped;
+}
+
+void Tracer::setEnabled(const bool e){
+	if (e && !enabled) { origin = Clock::now(); }
+	enabled = e;
+}
+
+void Tracer::record(const std::string& name, const char* category, const Clock::time_point begin, const Clock::time_point end){
+	Event e;
+	e.name = name;
+	e.category = category;
+	e.start = std::chrono::duration_cast<std::chrono::microseconds>(begin - origin).count();
+	e.duration = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+	e.thread = threadLane();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	events.push_back(e);
+}
+
+void Tracer::write(std::ostream& out){
+	std::lock_guard<std::mutex> lock(mutex);
+	const int pid = getpid();
+	out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+	for (size_t i = 0; i < events.size(); ++i) {
+		const Event& e = events[i];
+		out << (i ? ",\n" : "\n") << "  {\"name\": \"" << escapeJson(e.name) << "\", \"cat\": \"" << e.category
+			<< "\", \"ph\": \"X\", \"ts\": " << e.start << ", \"dur\": " << e.duration
+			<< ", \"pid\": " << pid << ", \"tid\": " << e.thread << "}";
+	}
+	out << "\n]}" << std::endl;
+}
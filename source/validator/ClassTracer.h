@@ -0,0 +1,81 @@
+/*********************************************************************************************************
+Tracer class records a timeline of spans, implemented via the singleton pattern
+	A span covers the lifetime of a scoped Tracer::Span object: parser steps, meeting generation,
+	validation phases, and every constraint. Spans of each thread are shown in a lane of their own.
+The timeline is written in the Chrome trace-event format, which can be opened in chrome://tracing or
+Perfetto. A disabled tracer only costs a boolean check per span.
+*********************************************************************************************************/
+#ifndef CLASSTRACER_H
+#define CLASSTRACER_H
+
+// Include std
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Tracer
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	// Scoped span: records a complete event from construction until it goes out of scope
+	class Span
+	{
+	public:
+		Span(const char* name, const char* category) : active(Tracer::get()->isEnabled()) {
+			if (active) { start(name, category); }
+		}
+		Span(const std::string& name, const char* category) : active(Tracer::get()->isEnabled()) {
+			if (active) { start(name, category); }
+		}
+		~Span() {
+			if (active) { Tracer::get()->record(name, category, begin, Clock::now()); }
+		}
+	private:
+		void start(const std::string& n, const char* c) { name = n; category = c; begin = Clock::now(); }
+
+		bool active;
+		std::string name;
+		const char* category = NULL;
+		Clock::time_point begin;
+	};
+
+	// Singleton pattern: public static accessor
+	static Tracer* get() {
+		if (!iTracer) { iTracer = new Tracer; }
+		return iTracer;
+	}
+
+	// Timestamps are relative to the moment the tracer is enabled
+	void setEnabled(const bool e);
+	bool isEnabled() const { return enabled; }
+
+	// Write all recorded spans as a Chrome trace-event JSON document
+	void write(std::ostream& out);
+
+private:
+	// constructor
+	Tracer() {}
+	~Tracer() {}
+
+	struct Event {
+		std::string name;
+		const char* category;
+		long long start; 		// Microseconds since the tracer was enabled
+		long long duration; 		// Microseconds
+		int thread;
+	};
+
+	void record(const std::string& name, const char* category, const Clock::time_point begin, const Clock::time_point end);
+
+	static Tracer* iTracer;
+
+	bool enabled = false;
+	Clock::time_point origin;
+	std::mutex mutex; 			// Guards the events of concurrent threads
+	std::vector<Event> events;
+};
+
+#endif /* CLASSTRACER_H */
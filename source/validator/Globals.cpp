@@ -1,3 +1,21 @@
 #include "Globals.h"
+#include <fstream>
 
 std::default_random_engine randEngine(0);
+
+uint64_t hashString(const std::string& str){
+	uint64_t hash = 14695981039346656037ULL;
+	for (unsigned char c : str) {
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+uint64_t hashFile(const std::string& fileName){
+	std::ifstream file(fileName, std::ios::in | std::ios::binary);
+	if (!file) { return 0; }
+	std::stringstream content;
+	content << file.rdbuf();
+	return hashString(content.str());
+}
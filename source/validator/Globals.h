@@ -1,6 +1,7 @@
 #include <string>
 #include <cmath>
 #include <random>
+#include <cstdint>
 
 // Forward declarations
 class League;
@@ -130,6 +131,10 @@ std::string idToString(T objects){
 }
 extern std::default_random_engine randEngine; 	/// Global random number generator
 
+// 64-bit FNV-1a hash of a string or file content, used to recognise identical instance files
+uint64_t hashString(const std::string& str);
+uint64_t hashFile(const std::string& fileName); 	// Zero if the file cannot be read
+
 
 #endif /* GLOBALS_H */
 